@@ -13,6 +13,44 @@
 #include <exception>
 #include <format>
 #include <set>
+#include <iostream>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <functional>
+#include <deque>
+#include <cstdio>
+#include <array>
+#include <optional>
+#include <bit>
+#include <stdexcept>
+#include <span>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define CSV_PARSER_POSIX 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__linux__)
+#define CSV_PARSER_PERF_COUNTERS 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define CSV_PARSER_X86_KERNELS 1
+#include <immintrin.h>
+#endif
 
 /* ======= Allowed containers & requirements ======= */
 
@@ -82,7 +120,7 @@ class WrongHeaderByDelimiter final : public CSVException {
         requires(sizeof...(Types) > 0)
     friend class CSVParser;
 
-    WrongHeaderByDelimiter(const std::string &filename, size_t detected_size, size_t expected_size, size_t row, char delimiter)
+    WrongHeaderByDelimiter(const std::string &filename, size_t detected_size, size_t expected_size, size_t row, const std::string &delimiter)
         : CSVException(std::format(
             "{} Failed to match header of size [{}] using delimiter '{}' on row [{}] in file '{}'.\n User's header has size {}.",
             error_mark, detected_size, delimiter, row, filename, expected_size)) {
@@ -185,6 +223,94 @@ class InsufficientOverload final : public CSVException {
     }
 };
 
+// Illegal: With UTF-8 validation enabled, every row must be well-formed UTF-8.
+class InvalidEncoding final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+
+    InvalidEncoding(const std::string &filename, const std::size_t row)
+        : CSVException(std::format("{} Invalid UTF-8 sequence on row [{}] in file '{}'.", error_mark, row, filename)) {
+    }
+};
+
+
+// Illegal: A checkpoint must be readable and point at a record boundary of its file.
+class InvalidCheckpoint final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+    friend struct CSVCheckpoint;
+
+    InvalidCheckpoint(const std::string &source, const std::string &reason)
+        : CSVException(std::format("{} Invalid checkpoint '{}': {}.", error_mark, source, reason)) {
+    }
+};
+
+
+// Illegal: A shared dataset must exist, be complete and have the column types it is attached with.
+class InvalidDataset final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+    template<typename... Columns>
+    friend class CSVSharedDataset;
+
+    InvalidDataset(const std::string &name, const std::string &reason)
+        : CSVException(std::format("{} Shared dataset '{}': {}.", error_mark, name, reason)) {
+    }
+};
+
+
+// Illegal: A key index must exist, be complete and be newer than the CSV file it indexes.
+class InvalidIndex final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+    friend class CSVFileIndex;
+
+    InvalidIndex(const std::string &path, const std::string &reason)
+        : CSVException(std::format("{} Key index '{}': {}.", error_mark, path, reason)) {
+    }
+};
+
+
+// Illegal: A projected column must exist in the file's header.
+class UnknownColumn final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+
+    UnknownColumn(const std::string &filename, const std::string &column)
+        : CSVException(std::format("{} Column '{}' is not in the header of file '{}'.", error_mark, column, filename)) {
+    }
+};
+
+
+// Illegal: The delimiter, quote and escape character must be distinct bytes, none of them a line break.
+class InvalidDialect final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+
+    InvalidDialect(const std::string &delimiter, const char quote, const char escape, const char *reason)
+        : CSVException(std::format("{} Invalid dialect (delimiter '{}', quote '{}', escape '{}'): {}.",
+                                   error_mark, delimiter, std::string(quote != '\0', quote), std::string(escape != '\0', escape), reason)) {
+    }
+};
+
+
+// Illegal: With an expected checksum set, the file's checksum must match it.
+class ChecksumMismatch final : public CSVException {
+    template<typename TObject, typename... Types>
+        requires(sizeof...(Types) > 0)
+    friend class CSVParser;
+
+    ChecksumMismatch(const std::string &filename, const char *algorithm, const std::uint64_t expected, const std::uint64_t actual)
+        : CSVException(std::format("{} {} checksum of file '{}' is {:#x}, expected {:#x}.", error_mark, algorithm, filename, actual, expected)) {
+    }
+};
+
 
 /* ======= Helper functions for Unique Type parsing ======= */
 
@@ -249,364 +375,6152 @@ constexpr std::size_t getMaxConstructibleArityMultipleTypes() {
 }
 
 
-/* ======= CSVParser class definition ======= */
+/* ======= Vectorized kernels (runtime dispatch) ======= */
 
-template<typename TObject, typename... Types>
-    requires(sizeof...(Types) > 0)
-class CSVParser {
-private:
-    using front_t = typename front_type<Types...>::type;
+// Instruction set levels, ordered from the most portable to the widest.
+enum class CSVKernelLevel { Scalar, SSE42, AVX2, AVX512 };
 
-    static constexpr std::size_t max_args_unique_type = getMaxConstructibleArityUniqueType<TObject, front_t, 40>();
-    static constexpr std::size_t max_args_multiple_types = getMaxConstructibleArityMultipleTypes<TObject, sizeof...(Types), Types...>();
+#ifdef CSV_PARSER_X86_KERNELS
+#define CSV_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#endif
 
-    static inline std::vector<char> default_delimiters = {',', '\t', ';', '|', ':', ' ', '~'};
-    static inline std::vector<char> default_quotes = {'"', '\''};
+// Hot byte-level loops used by the tokenizer and the converters. Each kernel is compiled once per
+// instruction set and the widest one supported by the host is selected once, at first use (cpuid).
+class CSVKernels {
+public:
+    struct Table {
+        CSVKernelLevel level;
+        const char *name;
+        // First position in [begin, end) holding 'a' or 'b', or end.
+        const char *(*find_structural)(const char *begin, const char *end, char a, char b);
+        // Number of occurrences of 'symbol' in [begin, end).
+        std::size_t (*count_byte)(const char *begin, const char *end, char symbol);
+        // True if [begin, end) is well-formed UTF-8.
+        bool (*validate_utf8)(const char *begin, const char *end);
+        // Length of the leading run of ASCII digits in [begin, end).
+        std::size_t (*count_digits)(const char *begin, const char *end);
+        // CRC32C (Castagnoli) of [begin, end), continuing from a previous CRC (0 to start).
+        std::uint32_t (*crc32c)(std::uint32_t crc, const char *begin, const char *end);
+        // Decodes the hex digit pairs in [begin, end) into (end - begin) / 2 bytes at 'out'; false on a non-hex digit.
+        bool (*decode_hex)(const char *begin, const char *end, std::uint8_t *out);
+        // Decodes the base64 quartets in [begin, end) (standard alphabet, no padding) into 3 bytes each; false on any
+        // other byte.
+        bool (*decode_base64)(const char *begin, const char *end, std::uint8_t *out);
+    };
 
-    std::vector<std::string> header;
-    bool custom_header = false, has_id = false;
-    static inline int objectIdCounter = 0;
-    char delimiter, quote;
-    int header_row;
+    // The widest level supported by the host CPU.
+    static CSVKernelLevel detect() {
+        static const CSVKernelLevel detected = [] {
+#ifdef CSV_PARSER_X86_KERNELS
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+                return CSVKernelLevel::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return CSVKernelLevel::AVX2;
+            }
+            if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+                return CSVKernelLevel::SSE42;
+            }
+#endif
+            return CSVKernelLevel::Scalar;
+        }();
+        return detected;
+    }
 
-    [[nodiscard]] bool checkMaxArgs(const std::size_t value) const {
-        switch (sizeof...(Types)) {
-            case 1:
-                return (max_args_unique_type == value || std::is_same_v<TObject, std::vector<front_t>>);
-            default:
-                return max_args_multiple_types == value;
-        }
+    static const Table &active() {
+        return *current().load(std::memory_order_acquire);
     }
 
-    [[nodiscard]] bool checkMaxArgs(const std::vector<std::string>& temp) const {
-        switch (sizeof...(Types)) {
-            case 1:
-                if (max_args_unique_type != temp.size() && !std::is_same_v<TObject, std::vector<front_t> >) {
-                    throw WrongHeaderLength(max_args_unique_type, temp);
-                }
-            break;
-            default:
-                if (max_args_multiple_types != temp.size()) {
-                    throw WrongHeaderLength(max_args_multiple_types, temp);
-                }
+    // Forces a kernel level (testing and benchmarking). Levels the host cannot run are clamped to detect().
+    static CSVKernelLevel force(CSVKernelLevel level) {
+        if (level > detect()) {
+            std::clog << std::format("[CSV Parser Error] Kernel level '{}' is not supported by this CPU. Using '{}'.",
+                                     tableFor(level).name, tableFor(detect()).name) << std::endl;
+            level = detect();
         }
-        return true;
+        current().store(&tableFor(level), std::memory_order_release);
+        return level;
     }
 
-    void setHeader(const std::vector<std::string>& temp) {
-        if (checkMaxArgs(temp)) {
-            header = temp;
-        }
+    // Restores the automatically detected kernel level.
+    static void reset() {
+        current().store(&tableFor(detect()), std::memory_order_release);
     }
 
-    static bool getBoolMeaning(const std::string &trimmed_boolean) {
-        std::string lower_temp = trimmed_boolean;
-        std::ranges::transform(lower_temp, lower_temp.begin(), ::tolower);
+    static const char *findStructural(const char *begin, const char *end, const char a, const char b) {
+        return active().find_structural(begin, end, a, b);
+    }
 
-        return (lower_temp[0] == 'y' || lower_temp[0] == 't' || lower_temp[0] == '1');
+    static std::size_t countByte(const char *begin, const char *end, const char symbol) {
+        return active().count_byte(begin, end, symbol);
     }
 
-    // Determines if the original header can be replaced with user's preferences.
-    // A function which checks and eventually predicts custom headers.
-    [[nodiscard]] std::pair<bool, char> trust_header(const std::string &filename);
+    static bool validateUTF8(const char *begin, const char *end) {
+        return active().validate_utf8(begin, end);
+    }
 
-    // Parses a single CSV formatted row.
-    TObject parseObjectFromRow(const std::string &row);
+    static std::size_t countDigits(const char *begin, const char *end) {
+        return active().count_digits(begin, end);
+    }
 
-    template <typename TCell>
-    TCell parseCSVCell(std::stringstream& ss, std::string cell);
+    static std::uint32_t crc32c(const std::uint32_t crc, const char *begin, const char *end) {
+        return active().crc32c(crc, begin, end);
+    }
 
-    struct NodeBase {
-        NodeBase *prev = nullptr;
-        NodeBase *next = nullptr;
-        std::string type;
+    static bool decodeHex(const char *begin, const char *end, std::uint8_t *out) {
+        return active().decode_hex(begin, end, out);
+    }
 
-        virtual ~NodeBase() = default;
-    };
+    static bool decodeBase64(const char *begin, const char *end, std::uint8_t *out) {
+        return active().decode_base64(begin, end, out);
+    }
 
-    template<typename T>
-    struct NodeMT final : NodeBase {
-        std::tuple<T> single_tuple;
-    };
+    // Value of one base64 digit (standard alphabet), or 0xFF.
+    static std::uint8_t base64Value(const char digit) {
+        static constexpr auto table = [] {
+            std::array<std::uint8_t, 256> entries{};
+            entries.fill(0xFF);
+            constexpr std::string_view alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (std::size_t i = 0; i < alphabet.size(); ++i) {
+                entries[static_cast<unsigned char>(alphabet[i])] = static_cast<std::uint8_t>(i);
+            }
+            return entries;
+        }();
+        return table[static_cast<unsigned char>(digit)];
+    }
+
+private:
+    static std::atomic<const Table *> &current() {
+        static std::atomic<const Table *> table{&tableFor(detect())};
+        return table;
+    }
 
-    template<typename Head>
-    void parseMultipleTypesObjectFromRow(std::stringstream &ss, char delimiter, NodeBase *&current);
+    static const Table &tableFor(const CSVKernelLevel level) {
+        static constexpr Table scalar{CSVKernelLevel::Scalar, "scalar", findStructuralScalar, countByteScalar, validateUTF8Scalar, countDigitsScalar, crc32cScalar, decodeHexScalar, decodeBase64Scalar};
+#ifdef CSV_PARSER_X86_KERNELS
+        static constexpr Table sse42{CSVKernelLevel::SSE42, "sse4.2", findStructuralSSE42, countByteSSE42, validateUTF8SSE42, countDigitsSSE42, crc32cSSE42, decodeHexSSE42, decodeBase64SSE42};
+        static constexpr Table avx2{CSVKernelLevel::AVX2, "avx2", findStructuralAVX2, countByteAVX2, validateUTF8AVX2, countDigitsAVX2, crc32cSSE42, decodeHexAVX2, decodeBase64AVX2};
+        static constexpr Table avx512{CSVKernelLevel::AVX512, "avx512", findStructuralAVX512, countByteAVX512, validateUTF8AVX512, countDigitsAVX512, crc32cSSE42, decodeHexAVX2, decodeBase64AVX2};
+
+        switch (level) {
+            case CSVKernelLevel::AVX512: return avx512;
+            case CSVKernelLevel::AVX2:   return avx2;
+            case CSVKernelLevel::SSE42:  return sse42;
+            default:                     return scalar;
+        }
+#else
+        (void) level;
+        return scalar;
+#endif
+    }
 
-    template<typename Head, typename... Tail>
-        requires(sizeof...(Tail) > 0)
-    void parseMultipleTypesObjectFromRow(std::stringstream &ss, char delimiter, NodeBase *&current);
+    /* Scalar kernels (also used for the tails of the vector loops) */
 
-    template<typename T>
-    T extractAndAdvance(NodeBase *&node);
+    static const char *findStructuralScalar(const char *begin, const char *end, const char a, const char b) {
+        while (begin < end && *begin != a && *begin != b) {
+            ++begin;
+        }
+        return begin;
+    }
 
-    template<typename... NodeTypes>
-    std::tuple<NodeTypes...> buildTupleFromNodes(NodeBase *&node);
+    static std::size_t countByteScalar(const char *begin, const char *end, const char symbol) {
+        return static_cast<std::size_t>(std::count(begin, end, symbol));
+    }
 
-    void showStats(const std::string& filename) {
-        std::string log_delimiter(1, delimiter);
-        if (delimiter == '\t') {
-            log_delimiter = "[TAB \\t]";
+    // Validates one code point starting at 'it' and advances past it.
+    static bool stepUTF8(const unsigned char *&it, const unsigned char *end) {
+        const unsigned char lead = *it;
+        if (lead < 0x80) {
+            ++it;
+            return true;
         }
-        std::cout << std::format("[CSV Reader] Fetching data from {}", filename) << std::endl;
-        if (custom_header) {
-            std::cout << std::format("[CSV Reader] Set header to user's preferences.") << std::endl;
+
+        std::size_t length;
+        std::uint32_t code_point;
+        if ((lead & 0xE0) == 0xC0) {
+            length = 2; code_point = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3; code_point = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4; code_point = lead & 0x07;
         } else {
-            std::cout << std::format("[CSV Reader] Set header from CSV (row: {} | delimiter: '{}' | quote: '{}')", header_row,
-                                     log_delimiter, quote) << std::endl;
+            return false;
         }
-        std::cout << std::format("[CSV Reader] Will retrieve data from the first {} columns, separated by '{}', quoted with '{}'",
-                                 header.size(), log_delimiter, quote) << std::endl;
-    }
 
-public:
-    // Create a CSV Parser using a predefined header.
-    explicit CSVParser(const std::vector<std::string> &header_)
-        : header({}),
-          delimiter('\0'),
-          quote('"'),
-          header_row(1){
-        try {
-            setHeader(header_);
-        } catch (WrongHeaderLength&) {
-            throw;
+        if (static_cast<std::size_t>(end - it) < length) {
+            return false;
+        }
+        for (std::size_t i = 1; i < length; ++i) {
+            if ((it[i] & 0xC0) != 0x80) {
+                return false;
+            }
+            code_point = (code_point << 6) | (it[i] & 0x3F);
         }
-    }
 
-    // Create a CSV Parser using default CSV file's header.
-    explicit CSVParser()
-        : header({}), delimiter('\0'), quote('"'),  header_row(1){
-    }
+        // Overlong encodings, UTF-16 surrogates and code points past U+10FFFF.
+        static constexpr std::uint32_t min_code_point[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (code_point < min_code_point[length] || (code_point >= 0xD800 && code_point <= 0xDFFF) || code_point > 0x10FFFF) {
+            return false;
+        }
 
-    // Set the CSV file's delimiter symbol.
-    void setDelimiter(const char delimiter_symbol) {
-        delimiter = delimiter_symbol;
+        it += length;
+        return true;
     }
 
-    // Set the CSV file's quotation symbol.
-    void setQuote(const char quotation_symbol) {
-        quote = quotation_symbol;
+    static bool validateUTF8Scalar(const char *begin, const char *end) {
+        auto it = reinterpret_cast<const unsigned char *>(begin);
+        const auto last = reinterpret_cast<const unsigned char *>(end);
+        while (it < last) {
+            if (!stepUTF8(it, last)) {
+                return false;
+            }
+        }
+        return true;
     }
 
-    // Set the CSV file's header row. Index should start from 1 (Not critical validation).
-    void setHeaderRow(const int row) {
-        if (row < 1) {
-            std::clog << std::format("[CSV Parser Error] Failed to set header row to [{}]. Reason: Index should start from 1.", row) << std::endl;
-            return;
+    static std::size_t countDigitsScalar(const char *begin, const char *end) {
+        const char *it = begin;
+        while (it < end && static_cast<unsigned char>(*it - '0') <= 9) {
+            ++it;
         }
-        header_row = row;
+        return static_cast<std::size_t>(it - begin);
     }
 
-    void initialize(std::string& row, std::ifstream& file, const std::string& filename) {
-        const std::pair<int, char> parseType(this->trust_header(filename));
+    static std::uint32_t crc32cScalar(const std::uint32_t crc, const char *begin, const char *end) {
+        static constexpr auto table = [] {
+            std::array<std::uint32_t, 256> entries{};
+            for (std::uint32_t byte = 0; byte < 256; ++byte) {
+                std::uint32_t value = byte;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value >> 1) ^ (0x82F63B78u & (0u - (value & 1u)));
+                }
+                entries[byte] = value;
+            }
+            return entries;
+        }();
 
-        custom_header = parseType.first;
-        delimiter = parseType.second;
+        std::uint32_t value = ~crc;
+        for (; begin < end; ++begin) {
+            value = table[(value ^ static_cast<unsigned char>(*begin)) & 0xFF] ^ (value >> 8);
+        }
+        return ~value;
+    }
 
-        if (!file.is_open()) {
-            throw FileOpenException(filename);
+    // Value of one hex digit, or 0xFF.
+    static std::uint8_t hexValue(const char digit) {
+        static constexpr auto table = [] {
+            std::array<std::uint8_t, 256> entries{};
+            entries.fill(0xFF);
+            for (int i = 0; i < 10; ++i) {
+                entries['0' + i] = static_cast<std::uint8_t>(i);
+            }
+            for (int i = 0; i < 6; ++i) {
+                entries['a' + i] = entries['A' + i] = static_cast<std::uint8_t>(10 + i);
+            }
+            return entries;
+        }();
+        return table[static_cast<unsigned char>(digit)];
+    }
+
+    static bool decodeHexScalar(const char *begin, const char *end, std::uint8_t *out) {
+        for (; end - begin >= 2; begin += 2) {
+            const std::uint8_t high = hexValue(begin[0]), low = hexValue(begin[1]);
+            if ((high | low) & 0xF0) {
+                return false;
+            }
+            *out++ = static_cast<std::uint8_t>(high << 4 | low);
         }
+        return true;
+    }
 
-        showStats(filename);
-        int row_counter(1);
-        do {
-            std::getline(file, row);
-            row_counter++;
-        } while (row_counter == header_row);
+    static bool decodeBase64Scalar(const char *begin, const char *end, std::uint8_t *out) {
+        for (; end - begin >= 4; begin += 4, out += 3) {
+            const std::uint32_t a = base64Value(begin[0]), b = base64Value(begin[1]), c = base64Value(begin[2]), d = base64Value(begin[3]);
+            if ((a | b | c | d) & 0xC0) {
+                return false;
+            }
+            const std::uint32_t triple = a << 18 | b << 12 | c << 6 | d;
+            out[0] = static_cast<std::uint8_t>(triple >> 16);
+            out[1] = static_cast<std::uint8_t>(triple >> 8);
+            out[2] = static_cast<std::uint8_t>(triple);
+        }
+        return true;
     }
 
-    template<template<typename...> class Container, typename K>
-        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
-    Container<K, TObject> parseObjectsFromFile(const std::string &filename);
+#ifdef CSV_PARSER_X86_KERNELS
+    /* SSE4.2 kernels (16 bytes per step) */
+
+    // Hardware CRC32C, shared by every vector level.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static std::uint32_t crc32cSSE42(const std::uint32_t crc, const char *begin, const char *end) {
+        std::uint64_t value = ~crc;
+        for (; end - begin >= 8; begin += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, begin, sizeof(word));
+            value = _mm_crc32_u64(value, word);
+        }
 
-    template<template<typename> class Container>
-        requires AllowedContainer<Container<TObject>>
-    Container<TObject> parseObjectsFromFile(const std::string &filename);
+        auto narrow = static_cast<std::uint32_t>(value);
+        for (; begin < end; ++begin) {
+            narrow = _mm_crc32_u8(narrow, static_cast<unsigned char>(*begin));
+        }
+        return ~narrow;
+    }
 
-    template<template<typename...> class Container, typename K>
-        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, std::shared_ptr<TObject>>>::value)
-    Container<K, std::shared_ptr<TObject>> parsePointerObjectsFromFile(const std::string &filename);
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static const char *findStructuralSSE42(const char *begin, const char *end, const char a, const char b) {
+        const __m128i va = _mm_set1_epi8(a), vb = _mm_set1_epi8(b);
+        for (; end - begin >= 16; begin += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+            const int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb)));
+            if (mask) {
+                return begin + __builtin_ctz(static_cast<unsigned>(mask));
+            }
+        }
+        return findStructuralScalar(begin, end, a, b);
+    }
 
-    template<template<typename> class Container>
-        requires AllowedContainer<Container<TObject>>
-    Container<std::shared_ptr<TObject>> parsePointerObjectsFromFile(const std::string &filename);
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static std::size_t countByteSSE42(const char *begin, const char *end, const char symbol) {
+        const __m128i vs = _mm_set1_epi8(symbol);
+        std::size_t count = 0;
+        for (; end - begin >= 16; begin += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+            count += __builtin_popcount(static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, vs))));
+        }
+        return count + countByteScalar(begin, end, symbol);
+    }
 
-    void inspect(const auto& container) {
-        try {
-            for (const auto& head : header) {
-                std::cout << head << "\t";
+    // ASCII blocks are skipped 16 bytes at a time; blocks holding multi-byte sequences go through stepUTF8.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static bool validateUTF8SSE42(const char *begin, const char *end) {
+        auto it = reinterpret_cast<const unsigned char *>(begin);
+        const auto last = reinterpret_cast<const unsigned char *>(end);
+        while (last - it >= 16) {
+            if (!_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(it)))) {
+                it += 16;
+                continue;
             }
-            std::cout << std::endl;
-            for (const auto& unit : container) {
-                try {
-                    if constexpr (is_unordered_map<std::decay_t<decltype(container)>>::value) {
-                        std::cout << unit.second << std::endl;
-                    } else {
-                        std::cout << unit << std::endl;
-                    }
-                } catch (std::exception&) {
-                    throw InsufficientOverload(typeid(unit).name());
+            for (const auto *stop = it + 16; it < stop;) {
+                if (!stepUTF8(it, last)) {
+                    return false;
                 }
             }
-        } catch (InsufficientOverload&) {
-            throw;
         }
+        return validateUTF8Scalar(reinterpret_cast<const char *>(it), end);
     }
 
-    void inspect_pointers(const auto& container) {
-        try {
-            for (const auto& head : header) {
-                std::cout << head << "\t";
-            }
-            std::cout << std::endl;
-            for (const auto& unit : container) {
-                try {
-                    if constexpr (is_unordered_map<std::decay_t<decltype(container)>>::value) {
-                        std::cout << *unit.second << std::endl;
-                    } else {
-                        std::cout << *unit << std::endl;
-                    }
-                } catch (std::exception&) {
-                    throw InsufficientOverload(typeid(unit).name());
-                }
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static std::size_t countDigitsSSE42(const char *begin, const char *end) {
+        const __m128i zero = _mm_set1_epi8('0'), nine = _mm_set1_epi8(9);
+        const char *it = begin;
+        for (; end - it >= 16; it += 16) {
+            const __m128i shifted = _mm_sub_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(it)), zero);
+            const unsigned mask = ~static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(shifted, nine), shifted))) & 0xFFFFu;
+            if (mask) {
+                return static_cast<std::size_t>(it - begin) + __builtin_ctz(mask);
             }
-        } catch (InsufficientOverload&) {
-            throw;
         }
+        return static_cast<std::size_t>(it - begin) + countDigitsScalar(it, end);
     }
 
-    ~CSVParser() = default;
-};
+    // Maps 16 hex digits to nibbles; 'valid' gets the movemask of the lanes that held a hex digit.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static __m128i hexNibblesSSE42(const __m128i chunk, unsigned &valid) {
+        const __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), chunk));
+        const __m128i letter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+        valid = static_cast<unsigned>(_mm_movemask_epi8(_mm_or_si128(digit, letter)));
+        return _mm_blendv_epi8(_mm_sub_epi8(lower, _mm_set1_epi8('a' - 10)), _mm_sub_epi8(chunk, _mm_set1_epi8('0')), digit);
+    }
+
+    // 32 digits per step: nibble pairs are merged with maddubs (high * 16 + low) and packed back to bytes.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static bool decodeHexSSE42(const char *begin, const char *end, std::uint8_t *out) {
+        const __m128i weights = _mm_set1_epi16(0x0110);
+        for (; end - begin >= 32; begin += 32, out += 16) {
+            unsigned valid_a, valid_b;
+            const __m128i a = hexNibblesSSE42(_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin)), valid_a);
+            const __m128i b = hexNibblesSSE42(_mm_loadu_si128(reinterpret_cast<const __m128i *>(begin + 16)), valid_b);
+            if ((valid_a & valid_b) != 0xFFFFu) {
+                return false;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_packus_epi16(_mm_maddubs_epi16(a, weights), _mm_maddubs_epi16(b, weights)));
+        }
+        return decodeHexScalar(begin, end, out);
+    }
+
+    // Base64 digits to sextets (W. Mula's nibble lookups): a non-zero 'lo & hi' marks a byte outside the alphabet,
+    // 'roll' is the offset from the ASCII code to the sextet. Returns false if any byte is invalid.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static bool base64SextetsSSE42(__m128i &chunk) {
+        const __m128i lut_lo = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m128i lut_hi = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+        const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(chunk, 4), mask_2f);
+        const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(chunk, mask_2f));
+        const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+        if (!_mm_testz_si128(lo, hi)) {
+            return false;
+        }
+        // '/' shares its high nibble with '+': the -1 of the comparison selects its own offset.
+        chunk = _mm_add_epi8(chunk, _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(chunk, mask_2f), hi_nibbles)));
+        return true;
+    }
+
+    // 16 digits per step: each 32-bit group of four sextets is merged into 24 bits with two multiply-adds, and the
+    // shuffle keeps their three bytes in order.
+    CSV_KERNEL_TARGET("sse4.2,popcnt")
+    static bool decodeBase64SSE42(const char *begin, const char *end, std::uint8_t *out) {
+        const __m128i order = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        for (; end - begin >= 16; begin += 16, out += 12) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+            if (!base64SextetsSSE42(chunk)) {
+                return false;
+            }
+            const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(chunk, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+            alignas(16) std::uint8_t bytes[16];
+            _mm_store_si128(reinterpret_cast<__m128i *>(bytes), _mm_shuffle_epi8(merged, order));
+            std::memcpy(out, bytes, 12);
+        }
+        return decodeBase64Scalar(begin, end, out);
+    }
+
+    /* AVX2 kernels (32 bytes per step) */
+
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static const char *findStructuralAVX2(const char *begin, const char *end, const char a, const char b) {
+        const __m256i va = _mm256_set1_epi8(a), vb = _mm256_set1_epi8(b);
+        for (; end - begin >= 32; begin += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+            const unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, va), _mm256_cmpeq_epi8(chunk, vb))));
+            if (mask) {
+                return begin + __builtin_ctz(mask);
+            }
+        }
+        return findStructuralSSE42(begin, end, a, b);
+    }
+
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static std::size_t countByteAVX2(const char *begin, const char *end, const char symbol) {
+        const __m256i vs = _mm256_set1_epi8(symbol);
+        std::size_t count = 0;
+        for (; end - begin >= 32; begin += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+            count += __builtin_popcount(static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, vs))));
+        }
+        return count + countByteSSE42(begin, end, symbol);
+    }
+
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static bool validateUTF8AVX2(const char *begin, const char *end) {
+        auto it = reinterpret_cast<const unsigned char *>(begin);
+        const auto last = reinterpret_cast<const unsigned char *>(end);
+        while (last - it >= 32) {
+            if (!_mm256_movemask_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(it)))) {
+                it += 32;
+                continue;
+            }
+            for (const auto *stop = it + 32; it < stop;) {
+                if (!stepUTF8(it, last)) {
+                    return false;
+                }
+            }
+        }
+        return validateUTF8SSE42(reinterpret_cast<const char *>(it), end);
+    }
+
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static std::size_t countDigitsAVX2(const char *begin, const char *end) {
+        const __m256i zero = _mm256_set1_epi8('0'), nine = _mm256_set1_epi8(9);
+        const char *it = begin;
+        for (; end - it >= 32; it += 32) {
+            const __m256i shifted = _mm256_sub_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(it)), zero);
+            const unsigned mask = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_min_epu8(shifted, nine), shifted)));
+            if (mask) {
+                return static_cast<std::size_t>(it - begin) + __builtin_ctz(mask);
+            }
+        }
+        return static_cast<std::size_t>(it - begin) + countDigitsSSE42(it, end);
+    }
+
+    // Also serves the AVX-512 level: the 16-byte UUIDs and short blobs this decodes rarely fill a 128-digit step.
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static bool decodeHexAVX2(const char *begin, const char *end, std::uint8_t *out) {
+        const __m256i weights = _mm256_set1_epi16(0x0110);
+        for (; end - begin >= 64; begin += 64, out += 32) {
+            __m256i nibbles[2];
+            for (int half = 0; half < 2; ++half) {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 32 * half));
+                const __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+                const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(chunk, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), chunk));
+                const __m256i letter = _mm256_and_si256(_mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('f' + 1), lower));
+                if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_or_si256(digit, letter))) != 0xFFFFFFFFu) {
+                    return false;
+                }
+                nibbles[half] = _mm256_maddubs_epi16(_mm256_blendv_epi8(_mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10)), _mm256_sub_epi8(chunk, _mm256_set1_epi8('0')), digit), weights);
+            }
+            // packus works per 128-bit lane; the permute restores byte order.
+            const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(nibbles[0], nibbles[1]), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), packed);
+        }
+        return decodeHexSSE42(begin, end, out);
+    }
+
+    // Same lookups as base64SextetsSSE42 on both lanes; the lanes' 12 bytes are joined with a cross-lane permute.
+    CSV_KERNEL_TARGET("avx2,popcnt")
+    static bool decodeBase64AVX2(const char *begin, const char *end, std::uint8_t *out) {
+        const __m256i lut_lo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+                                                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+        const __m256i lut_hi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+                                                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+        const __m256i lut_roll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                  0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i order = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                               2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+        const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+        for (; end - begin >= 32; begin += 32, out += 24) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+            const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(chunk, 4), mask_2f);
+            const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(chunk, mask_2f));
+            const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            if (!_mm256_testz_si256(lo, hi)) {
+                return false;
+            }
+            chunk = _mm256_add_epi8(chunk, _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(chunk, mask_2f), hi_nibbles)));
+            const __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(chunk, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+            const __m256i packed = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(merged, order), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+            alignas(32) std::uint8_t bytes[32];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(bytes), packed);
+            std::memcpy(out, bytes, 24);
+        }
+        return decodeBase64SSE42(begin, end, out);
+    }
+
+    /* AVX-512 kernels (64 bytes per step) */
+
+    CSV_KERNEL_TARGET("avx512f,avx512bw,avx2,popcnt")
+    static const char *findStructuralAVX512(const char *begin, const char *end, const char a, const char b) {
+        const __m512i va = _mm512_set1_epi8(a), vb = _mm512_set1_epi8(b);
+        for (; end - begin >= 64; begin += 64) {
+            const __m512i chunk = _mm512_loadu_si512(begin);
+            const std::uint64_t mask = _mm512_cmpeq_epi8_mask(chunk, va) | _mm512_cmpeq_epi8_mask(chunk, vb);
+            if (mask) {
+                return begin + __builtin_ctzll(mask);
+            }
+        }
+        return findStructuralAVX2(begin, end, a, b);
+    }
+
+    CSV_KERNEL_TARGET("avx512f,avx512bw,avx2,popcnt")
+    static std::size_t countByteAVX512(const char *begin, const char *end, const char symbol) {
+        const __m512i vs = _mm512_set1_epi8(symbol);
+        std::size_t count = 0;
+        for (; end - begin >= 64; begin += 64) {
+            count += __builtin_popcountll(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(begin), vs));
+        }
+        return count + countByteAVX2(begin, end, symbol);
+    }
+
+    CSV_KERNEL_TARGET("avx512f,avx512bw,avx2,popcnt")
+    static bool validateUTF8AVX512(const char *begin, const char *end) {
+        auto it = reinterpret_cast<const unsigned char *>(begin);
+        const auto last = reinterpret_cast<const unsigned char *>(end);
+        while (last - it >= 64) {
+            if (!_mm512_movepi8_mask(_mm512_loadu_si512(it))) {
+                it += 64;
+                continue;
+            }
+            for (const auto *stop = it + 64; it < stop;) {
+                if (!stepUTF8(it, last)) {
+                    return false;
+                }
+            }
+        }
+        return validateUTF8AVX2(reinterpret_cast<const char *>(it), end);
+    }
+
+    CSV_KERNEL_TARGET("avx512f,avx512bw,avx2,popcnt")
+    static std::size_t countDigitsAVX512(const char *begin, const char *end) {
+        const __m512i zero = _mm512_set1_epi8('0'), nine = _mm512_set1_epi8(9);
+        const char *it = begin;
+        for (; end - it >= 64; it += 64) {
+            const __m512i shifted = _mm512_sub_epi8(_mm512_loadu_si512(it), zero);
+            const std::uint64_t mask = ~_mm512_cmple_epu8_mask(shifted, nine);
+            if (mask) {
+                return static_cast<std::size_t>(it - begin) + __builtin_ctzll(mask);
+            }
+        }
+        return static_cast<std::size_t>(it - begin) + countDigitsAVX2(it, end);
+    }
+#endif
+};
+
+
+/* ======= Checksums ======= */
+
+enum class CSVChecksum { None, CRC32C, XXH64 };
+
+// Streaming XXH64 (seed 0).
+class CSVXXH64 {
+public:
+    void update(const char *begin, const char *end) {
+        const auto *input = reinterpret_cast<const unsigned char *>(begin);
+        auto length = static_cast<std::size_t>(end - begin);
+        total += length;
+
+        if (buffered + length < 32) {
+            std::memcpy(buffer + buffered, input, length);
+            buffered += length;
+            return;
+        }
+        if (buffered) {
+            const std::size_t fill = 32 - buffered;
+            std::memcpy(buffer + buffered, input, fill);
+            consume(buffer);
+            input += fill;
+            length -= fill;
+            buffered = 0;
+        }
+        for (; length >= 32; input += 32, length -= 32) {
+            consume(input);
+        }
+        std::memcpy(buffer, input, length);
+        buffered = length;
+    }
+
+    [[nodiscard]] std::uint64_t digest() const {
+        std::uint64_t hash;
+        if (total >= 32) {
+            hash = rotate(lanes[0], 1) + rotate(lanes[1], 7) + rotate(lanes[2], 12) + rotate(lanes[3], 18);
+            for (const std::uint64_t lane: lanes) {
+                hash = (hash ^ round(0, lane)) * prime1 + prime4;
+            }
+        } else {
+            hash = prime5;
+        }
+        hash += total;
+
+        const unsigned char *tail = buffer, *last = buffer + buffered;
+        for (; last - tail >= 8; tail += 8) {
+            hash = rotate(hash ^ round(0, read64(tail)), 27) * prime1 + prime4;
+        }
+        if (last - tail >= 4) {
+            hash = rotate(hash ^ (read32(tail) * prime1), 23) * prime2 + prime3;
+            tail += 4;
+        }
+        for (; tail < last; ++tail) {
+            hash = rotate(hash ^ (*tail * prime5), 11) * prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+private:
+    static constexpr std::uint64_t prime1 = 0x9E3779B185EBCA87ull, prime2 = 0xC2B2AE3D27D4EB4Full,
+                                   prime3 = 0x165667B19E3779F9ull, prime4 = 0x85EBCA77C2B2AE63ull,
+                                   prime5 = 0x27D4EB2F165667C5ull;
+
+    static std::uint64_t rotate(const std::uint64_t value, const int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static std::uint64_t round(const std::uint64_t accumulator, const std::uint64_t lane) {
+        return rotate(accumulator + lane * prime2, 31) * prime1;
+    }
+
+    static std::uint64_t read64(const unsigned char *bytes) {
+        std::uint64_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    static std::uint64_t read32(const unsigned char *bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    void consume(const unsigned char *stripe) {
+        for (int lane = 0; lane < 4; ++lane) {
+            lanes[lane] = round(lanes[lane], read64(stripe + 8 * lane));
+        }
+    }
+
+    std::uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0ull - prime1};
+    std::uint64_t total = 0;
+    unsigned char buffer[32] = {};
+    std::size_t buffered = 0;
+};
+
+// Running checksum of the raw bytes of a file, updated by CSVBlockReader as blocks are read.
+class CSVChecksumState {
+public:
+    explicit CSVChecksumState(const CSVChecksum type_ = CSVChecksum::None) : algorithm(type_) {
+    }
+
+    void update(const char *begin, const char *end) {
+        if (algorithm == CSVChecksum::CRC32C) {
+            crc = CSVKernels::crc32c(crc, begin, end);
+        } else if (algorithm == CSVChecksum::XXH64) {
+            xxh.update(begin, end);
+        }
+    }
+
+    [[nodiscard]] std::uint64_t value() const {
+        return algorithm == CSVChecksum::XXH64 ? xxh.digest() : crc;
+    }
+
+    [[nodiscard]] CSVChecksum type() const {
+        return algorithm;
+    }
+
+    static const char *name(const CSVChecksum type) {
+        switch (type) {
+            case CSVChecksum::CRC32C: return "CRC32C";
+            case CSVChecksum::XXH64:  return "XXH64";
+            default:                  return "none";
+        }
+    }
+
+    // CRC32C of A followed by B, from crc(A), crc(B) and the length of B (GF(2) matrix method, as zlib's crc32_combine).
+    static std::uint32_t combineCRC32C(std::uint32_t first, const std::uint32_t second, std::uint64_t second_length) {
+        if (!second_length) {
+            return first;
+        }
+
+        std::uint32_t even[32], odd[32];
+        odd[0] = 0x82F63B78u;
+        for (std::uint32_t bit = 1, row = 1; bit < 32; ++bit, row <<= 1) {
+            odd[bit] = row;
+        }
+        square(even, odd);      // Operator for 2 zero bits.
+        square(odd, even);      // Operator for 4 zero bits.
+
+        do {
+            square(even, odd);
+            if (second_length & 1) {
+                first = times(even, first);
+            }
+            second_length >>= 1;
+            if (!second_length) {
+                break;
+            }
+            square(odd, even);
+            if (second_length & 1) {
+                first = times(odd, first);
+            }
+            second_length >>= 1;
+        } while (second_length);
+
+        return first ^ second;
+    }
+
+private:
+    static std::uint32_t times(const std::uint32_t *matrix, std::uint32_t vector) {
+        std::uint32_t sum = 0;
+        for (; vector; vector >>= 1, ++matrix) {
+            if (vector & 1) {
+                sum ^= *matrix;
+            }
+        }
+        return sum;
+    }
+
+    static void square(std::uint32_t *result, const std::uint32_t *matrix) {
+        for (int row = 0; row < 32; ++row) {
+            result[row] = times(matrix, matrix[row]);
+        }
+    }
+
+    CSVChecksum algorithm;
+    std::uint32_t crc = 0;
+    CSVXXH64 xxh;
+};
+
+
+/* ======= Row tokenizer ======= */
+
+// Splits one CSV row into fields. Quoted fields are unescaped in place ("" -> "), so every view points into the row buffer.
+// Dialects with a multi-byte delimiter or an escape character take a second path: the kernel still finds the candidates
+// (first delimiter byte, quote or escape), and a delimiter candidate is confirmed by comparing its remaining bytes.
+struct CSVTokenizer {
+    static constexpr std::size_t max_delimiter_length = 8;
+
+    char delimiter;
+    char quote;
+    // Bytes of a multi-byte delimiter after its first one ('delimiter'), e.g. "|" for "||".
+    std::array<char, max_delimiter_length - 1> delimiter_tail{};
+    std::uint8_t delimiter_tail_length = 0;
+    // Escape character (e.g. '\\'): the byte after it is taken literally, inside or outside quotes. '\0' for none.
+    char escape = '\0';
+
+    // Dialect with a delimiter of 1 to max_delimiter_length bytes (longer ones are truncated).
+    static CSVTokenizer withDelimiter(const std::string_view text, const char quote_, const char escape_ = '\0') {
+        CSVTokenizer tokenizer{text.empty() ? '\0' : text.front(), quote_};
+        const std::size_t tail = std::min(text.size(), max_delimiter_length) - !text.empty();
+        std::copy_n(text.data() + 1, tail, tokenizer.delimiter_tail.begin());
+        tokenizer.delimiter_tail_length = static_cast<std::uint8_t>(tail);
+        tokenizer.escape = escape_;
+        return tokenizer;
+    }
+
+    [[nodiscard]] std::string delimiterText() const {
+        return std::string(1, delimiter) + std::string(delimiter_tail.data(), delimiter_tail_length);
+    }
+
+    // Why the dialect cannot be tokenized unambiguously, or nullptr if it can: the delimiter bytes, the quote and the
+    // escape character must not overlap, and none may be a line break.
+    [[nodiscard]] const char *invalidReason() const {
+        if (delimiter_tail_length >= max_delimiter_length) {
+            return "the delimiter is longer than 8 bytes";
+        }
+        const std::string_view text(delimiter_tail.data(), delimiter_tail_length);
+        const auto in_delimiter = [&](const char symbol) {
+            return symbol == delimiter || text.find(symbol) != std::string_view::npos;
+        };
+        const auto line_break = [](const char symbol) {
+            return symbol == '\n' || symbol == '\r';
+        };
+        if (delimiter == '\0' || in_delimiter('\n') || in_delimiter('\r') || line_break(quote) || line_break(escape)) {
+            return "the delimiter is empty or a byte is a line break";
+        }
+        if (in_delimiter(quote)) {
+            return "the quote is part of the delimiter";
+        }
+        if (escape != '\0' && (escape == quote || in_delimiter(escape))) {
+            return "the escape character is the quote or part of the delimiter";
+        }
+        return nullptr;
+    }
+
+    void split(char *begin, char *end, std::vector<std::string_view> &fields) const {
+        fields.clear();
+        if (delimiter_tail_length || escape) {
+            splitExtended(begin, end, fields);
+            return;
+        }
+        char *cursor = begin;
+
+        while (true) {
+            if (cursor < end && *cursor == quote) {
+                cursor = splitQuoted(cursor, end, fields);
+            } else {
+                char *next = const_cast<char *>(CSVKernels::findStructural(cursor, end, delimiter, delimiter));
+                fields.emplace_back(cursor, static_cast<std::size_t>(next - cursor));
+                cursor = next;
+            }
+
+            if (cursor == end) {
+                return;
+            }
+            ++cursor;   // Skips the delimiter.
+        }
+    }
+
+    // Offset (from 'begin') of the opening quote of an unterminated quoted field, or npos. Leaves the row untouched.
+    [[nodiscard]] std::size_t findUnterminatedQuote(const char *begin, const char *end) const {
+        // Without an escape character, the second byte searched for is the quote (or delimiter) again.
+        const char quote_stop = escape ? escape : quote, stop = escape ? escape : delimiter;
+        const char *cursor = begin;
+        while (true) {
+            if (cursor < end && *cursor == quote) {
+                const char *read = cursor + 1;
+                while (true) {
+                    const char *hit = CSVKernels::findStructural(read, end, quote, quote_stop);
+                    if (hit == end) {
+                        return static_cast<std::size_t>(cursor - begin);
+                    }
+                    if (escape && *hit == escape) {
+                        read = std::min(hit + 2, end);
+                        continue;
+                    }
+                    if (hit + 1 < end && hit[1] == quote) {
+                        read = hit + 2;
+                        continue;
+                    }
+                    cursor = hit + 1;
+                    break;
+                }
+            }
+            while (true) {
+                const char *hit = CSVKernels::findStructural(cursor, end, delimiter, stop);
+                if (hit == end) {
+                    return std::string_view::npos;
+                }
+                if (escape && *hit == escape) {
+                    cursor = std::min(hit + 2, end);
+                } else if (delimiterAt(hit, end)) {
+                    cursor = hit + 1 + delimiter_tail_length;
+                    break;
+                } else {
+                    cursor = hit + 1;
+                }
+            }
+        }
+    }
+
+private:
+    // True if a whole delimiter starts at 'at', whose first byte is known to match.
+    [[nodiscard]] bool delimiterAt(const char *at, const char *end) const {
+        return static_cast<std::size_t>(end - at) > delimiter_tail_length &&
+               std::memcmp(at + 1, delimiter_tail.data(), delimiter_tail_length) == 0;
+    }
+
+    // Multi-byte delimiter and / or escape character. Escaped bytes are compacted in place, like doubled quotes.
+    void splitExtended(char *begin, char *end, std::vector<std::string_view> &fields) const {
+        const char quote_stop = escape ? escape : quote, stop = escape ? escape : delimiter;
+        char *cursor = begin;
+
+        while (true) {
+            const bool quoted = cursor < end && *cursor == quote;
+            char *read = cursor + quoted, *field_begin = read, *write = read;
+
+            while (quoted) {
+                char *hit = const_cast<char *>(CSVKernels::findStructural(read, end, quote, quote_stop));
+                std::memmove(write, read, static_cast<std::size_t>(hit - read));
+                write += hit - read;
+                if (hit == end) {   // Unterminated: keeps the rest of the row.
+                    read = end;
+                    break;
+                }
+                if (escape && *hit == escape) {
+                    read = hit + 1;
+                    if (read < end) {
+                        *write++ = *read++;
+                    }
+                    continue;
+                }
+                if (hit + 1 < end && hit[1] == quote) {
+                    *write++ = quote;
+                    read = hit + 2;
+                    continue;
+                }
+                read = hit + 1;
+                break;
+            }
+
+            // Unquoted text, or the characters between the closing quote and the delimiter (kept).
+            while (true) {
+                char *hit = const_cast<char *>(CSVKernels::findStructural(read, end, delimiter, stop));
+                std::memmove(write, read, static_cast<std::size_t>(hit - read));
+                write += hit - read;
+                if (hit == end) {
+                    read = end;
+                    break;
+                }
+                if (escape && *hit == escape) {
+                    read = hit + 1;
+                    if (read < end) {
+                        *write++ = *read++;
+                    }
+                    continue;
+                }
+                if (delimiterAt(hit, end)) {
+                    read = hit;
+                    break;
+                }
+                *write++ = *hit;    // First byte of the delimiter, not followed by the rest of it.
+                read = hit + 1;
+            }
+
+            fields.emplace_back(field_begin, static_cast<std::size_t>(write - field_begin));
+            if (read == end) {
+                return;
+            }
+            cursor = read + 1 + delimiter_tail_length;
+        }
+    }
+
+    // Returns the position of the delimiter ending the quoted field, or end.
+    char *splitQuoted(char *cursor, char *end, std::vector<std::string_view> &fields) const {
+        char *field_begin = cursor + 1, *read = cursor + 1, *write = nullptr;
+
+        while (true) {
+            char *hit = const_cast<char *>(CSVKernels::findStructural(read, end, quote, quote));
+            if (write) {
+                std::memmove(write, read, static_cast<std::size_t>(hit - read));
+                write += hit - read;
+            }
+            if (hit == end) {   // Unterminated: keeps the rest of the row.
+                write = write ? write : end;
+                read = end;
+                break;
+            }
+            if (hit + 1 < end && hit[1] == quote) {
+                write = write ? write : hit;
+                *write++ = quote;
+                read = hit + 2;
+                continue;
+            }
+            write = write ? write : hit;
+            read = hit + 1;
+            break;
+        }
+
+        // Characters between the closing quote and the delimiter are kept.
+        char *next = const_cast<char *>(CSVKernels::findStructural(read, end, delimiter, delimiter));
+        std::memmove(write, read, static_cast<std::size_t>(next - read));
+        write += next - read;
+
+        fields.emplace_back(field_begin, static_cast<std::size_t>(write - field_begin));
+        return next;
+    }
+};
+
+
+/* ======= Timeline trace ======= */
+
+// Spans of parse phases per thread (see CSVParser::setTrace()), exported as Chrome trace JSON for chrome://tracing or
+// ui.perfetto.dev. Each thread appends to a buffer of its own, registered under a mutex the first time the thread
+// records into this trace: recording itself takes no lock. Export and clear() only while no parse is running.
+class CSVTrace {
+    using Clock = std::chrono::steady_clock;
+
+public:
+    CSVTrace() : id(next_id.fetch_add(1) + 1), origin(Clock::now()) {
+    }
+
+    CSVTrace(const CSVTrace &) = delete;
+    CSVTrace &operator=(const CSVTrace &) = delete;
+
+    // Records the span from its construction to its destruction on the calling thread. No-op with a null trace.
+    class Span {
+    public:
+        Span(CSVTrace *trace_, const char *name_) : trace(trace_), name(name_), begin(trace_ ? Clock::now() : Clock::time_point{}) {
+        }
+
+        Span(const Span &) = delete;
+        Span &operator=(const Span &) = delete;
+
+        ~Span() {
+            if (trace) {
+                trace->record(name, begin, Clock::now(), arg_name, arg);
+            }
+        }
+
+        // One numeric argument shown with the span (e.g. "rows").
+        void setArg(const char *arg_name_, const std::uint64_t value) {
+            arg_name = arg_name_;
+            arg = value;
+        }
+
+    private:
+        CSVTrace *trace;
+        const char *name;
+        Clock::time_point begin;
+        const char *arg_name = nullptr;
+        std::uint64_t arg = 0;
+    };
+
+    // Records [begin, end) on the calling thread. 'name' and 'arg_name' must be string literals.
+    void record(const char *name, const Clock::time_point begin, const Clock::time_point end, const char *arg_name = nullptr,
+                const std::uint64_t arg = 0) {
+        threadBuffer().events.push_back({name, arg_name, arg, toNanoseconds(begin), toNanoseconds(end)});
+    }
+
+    // Names the calling thread in the exported trace (e.g. "worker 2").
+    void nameThread(std::string name) {
+        threadBuffer().name = std::move(name);
+    }
+
+    [[nodiscard]] std::size_t spanCount() const {
+        std::lock_guard lock(mutex);
+        std::size_t count = 0;
+        for (const ThreadBuffer &buffer: buffers) {
+            count += buffer.events.size();
+        }
+        return count;
+    }
+
+    void clear() {
+        std::lock_guard lock(mutex);
+        for (ThreadBuffer &buffer: buffers) {
+            buffer.events.clear();
+        }
+        origin = Clock::now();
+    }
+
+    // Chrome trace event format: one complete ("X") event per span, timestamps in microseconds from the trace's
+    // creation (or last clear()), plus a thread_name metadata event per thread.
+    [[nodiscard]] std::string toJSON() const {
+        std::lock_guard lock(mutex);
+        std::string json = "{\"traceEvents\":[";
+        bool first = true;
+        const auto separator = [&] {
+            json += first ? "\n" : ",\n";
+            first = false;
+        };
+        for (const ThreadBuffer &buffer: buffers) {
+            separator();
+            json += std::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", buffer.tid,
+                                escape(buffer.name));
+            for (const Event &event: buffer.events) {
+                separator();
+                json += std::format(R"({{"name":"{}","cat":"csv","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f})",
+                                    event.name, buffer.tid, static_cast<double>(event.begin) / 1e3,
+                                    static_cast<double>(event.end - event.begin) / 1e3);
+                if (event.arg_name) {
+                    json += std::format(R"(,"args":{{"{}":{}}})", event.arg_name, event.arg);
+                }
+                json += '}';
+            }
+        }
+        json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return json;
+    }
+
+    // Writes toJSON() to 'path'. Returns false if the file cannot be written.
+    bool write(const std::string &path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        const std::string json = toJSON();
+        file.write(json.data(), static_cast<std::streamsize>(json.size()));
+        return static_cast<bool>(file.flush());
+    }
+
+private:
+    struct Event {
+        const char *name;
+        const char *arg_name;
+        std::uint64_t arg;
+        std::uint64_t begin, end;   // Nanoseconds since 'origin'.
+    };
+
+    struct ThreadBuffer {
+        std::thread::id thread;
+        unsigned tid;
+        std::string name;
+        std::vector<Event> events;
+    };
+
+    // The calling thread's buffer. The last one used is cached per thread, keyed by the trace's id (not its address,
+    // which a later trace may reuse).
+    ThreadBuffer &threadBuffer() {
+        thread_local std::uint64_t cached_id = 0;
+        thread_local ThreadBuffer *cached = nullptr;
+        if (cached_id == id) {
+            return *cached;
+        }
+
+        std::lock_guard lock(mutex);
+        const std::thread::id self = std::this_thread::get_id();
+        auto found = std::ranges::find(buffers, self, &ThreadBuffer::thread);
+        if (found == buffers.end()) {
+            const auto tid = static_cast<unsigned>(buffers.size());
+            buffers.push_back({self, tid, std::format("thread {}", tid), {}});
+            found = std::prev(buffers.end());
+        }
+        cached_id = id;
+        cached = &*found;
+        return *cached;
+    }
+
+    [[nodiscard]] std::uint64_t toNanoseconds(const Clock::time_point time) const {
+        return time > origin ? static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(time - origin).count()) : 0;
+    }
+
+    static std::string escape(const std::string_view text) {
+        std::string escaped;
+        for (const char symbol: text) {
+            if (symbol == '"' || symbol == '\\') {
+                escaped.push_back('\\');
+            }
+            escaped.push_back(static_cast<unsigned char>(symbol) < 0x20 ? ' ' : symbol);
+        }
+        return escaped;
+    }
+
+    static inline std::atomic<std::uint64_t> next_id{0};
+
+    const std::uint64_t id;
+    Clock::time_point origin;
+    mutable std::mutex mutex;
+    std::deque<ThreadBuffer> buffers;   // A deque: buffers never move once handed to their thread.
+};
+
+
+/* ======= Block reader ======= */
+
+// Reads a byte range of a file in large blocks and yields its lines (without the line ending).
+// Lines are handed out as mutable ranges of the internal buffer, valid until the next call.
+class CSVBlockReader {
+public:
+    static constexpr std::size_t default_block_size = 1 << 20;
+
+    explicit CSVBlockReader(const std::size_t block_size_ = default_block_size) : block_size(block_size_) {
+    }
+
+    // Opens [begin, end) of the file. 'begin' must be the start of a line.
+    bool open(const std::string &filename, const std::uint64_t begin = 0,
+              const std::uint64_t end = std::numeric_limits<std::uint64_t>::max()) {
+        file.close();
+        file.clear();
+        file.rdbuf()->pubsetbuf(nullptr, 0);   // Blocks are read straight into 'buffer'.
+        file.open(filename, std::ios::binary);
+        if (begin) {
+            file.seekg(static_cast<std::streamoff>(begin));
+        }
+        position = begin;
+        limit = end;
+        head = tail = scanned = 0;
+        exhausted = false;
+        return file.is_open() && file.good();
+    }
+
+    bool nextLine(char *&line_begin, char *&line_end) {
+        while (true) {
+            // A line longer than a block is searched from where the previous search stopped, not from its start:
+            // rescanning it after every refill would be quadratic in its length.
+            char *first = buffer.data() + head, *last = buffer.data() + tail;
+            char *newline = const_cast<char *>(CSVKernels::findStructural(buffer.data() + std::max(head, scanned), last, '\n', '\n'));
+
+            if (newline != last || (exhausted && first != last)) {
+                line_begin = first;
+                line_end = newline;
+                head = static_cast<std::size_t>(newline - buffer.data()) + (newline != last);
+                if (line_end != line_begin && line_end[-1] == '\r') {
+                    --line_end;
+                }
+                return true;
+            }
+
+            if (exhausted) {
+                return false;
+            }
+            scanned = tail;
+            refill();
+        }
+    }
+
+    // Every byte read from now on is added to 'state' (nullptr to stop).
+    void setChecksum(CSVChecksumState *state) {
+        checksum = state;
+    }
+
+    // Records a "read block" span per block read (nullptr to stop).
+    void setTrace(CSVTrace *trace_) {
+        trace = trace_;
+    }
+
+    // File offset of the first byte not yet handed out (the start of the next line).
+    [[nodiscard]] std::uint64_t offset() const {
+        return position + head;
+    }
+
+private:
+    // Moves the unread tail to the front of the buffer and appends the next block.
+    void refill() {
+        position += head;
+        if (head) {
+            std::memmove(buffer.data(), buffer.data() + head, tail - head);
+        }
+        tail -= head;
+        scanned -= std::min(scanned, head);
+        head = 0;
+
+        if (buffer.size() < tail + block_size) {
+            buffer.resize(tail + block_size);
+        }
+
+        const std::uint64_t remaining = limit - (position + tail);
+        const auto wanted = static_cast<std::streamsize>(std::min<std::uint64_t>(block_size, remaining));
+        CSVTrace::Span span(trace, "read block");
+        file.read(buffer.data() + tail, wanted);
+        const auto received = static_cast<std::size_t>(file.gcount());
+        span.setArg("bytes", received);
+        if (checksum) {
+            checksum->update(buffer.data() + tail, buffer.data() + tail + received);
+        }
+        tail += received;
+
+        if (received < static_cast<std::size_t>(wanted) || position + tail >= limit) {
+            exhausted = true;
+        }
+    }
+
+    std::ifstream file;
+    std::string buffer;
+    std::size_t block_size, head = 0, tail = 0;
+    std::size_t scanned = 0;    // Buffer offset up to which the current line is known to hold no newline.
+    std::uint64_t position = 0, limit = 0;
+    bool exhausted = true;
+    CSVChecksumState *checksum = nullptr;
+    CSVTrace *trace = nullptr;
+};
+
+
+/* ======= LZ block codec ======= */
+
+// Byte-oriented LZ77 codec in the LZ4 block style: a token (literal count, match length - 4), the literals, a 16-bit
+// match offset, with 255-continued length bytes. A 4096-entry hash table (16 KiB, on the stack) finds matches; no
+// entropy coding. Rows of numbers and varied text compress about 1.7-2x, repetitive rows about 4x, at 350-1100 MB/s.
+// Blocks are decoded knowing their raw size.
+class CSVLZ {
+public:
+    // Appends the compressed form of [begin, end) to 'out'.
+    static void compress(const char *begin, const char *end, std::string &out) {
+        const auto *source = reinterpret_cast<const unsigned char *>(begin);
+        const auto size = static_cast<std::size_t>(end - begin);
+        std::array<std::uint32_t, 1 << hash_bits> table{};     // Position + 1 of the last sequence with this hash.
+        std::size_t position = 0, anchor = 0;
+
+        while (size >= min_match + tail_literals && position + min_match + tail_literals <= size) {
+            const std::uint32_t sequence = read32(source + position);
+            std::uint32_t &slot = table[(sequence * 2654435761u) >> (32 - hash_bits)];
+            const std::size_t candidate = slot;
+            slot = static_cast<std::uint32_t>(position + 1);
+
+            if (!candidate || position + 1 - candidate > max_offset || read32(source + candidate - 1) != sequence) {
+                ++position;
+                continue;
+            }
+
+            const std::size_t match = candidate - 1;
+            std::size_t length = min_match;
+            while (position + length + tail_literals < size && source[match + length] == source[position + length]) {
+                ++length;
+            }
+            emit(out, source + anchor, position - anchor, position - match, length);
+            position += length;
+            anchor = position;
+        }
+        emit(out, source + anchor, size - anchor, 0, 0);
+    }
+
+    // Decodes 'raw_size' bytes from the compressed block at 'in' into 'out'.
+    static void decompress(const char *in, const std::size_t raw_size, char *out) {
+        const auto *input = reinterpret_cast<const unsigned char *>(in);
+        std::size_t written = 0;
+
+        while (true) {
+            const unsigned token = *input++;
+            const std::size_t literals = readLength(input, token >> 4);
+            std::memcpy(out + written, input, literals);
+            input += literals;
+            written += literals;
+            if (written >= raw_size) {
+                return;
+            }
+
+            const std::size_t offset = input[0] | (input[1] << 8);
+            input += 2;
+            const std::size_t length = readLength(input, token & 15) + min_match;
+            // Byte by byte: the match may overlap the bytes it produces.
+            for (std::size_t copied = 0; copied < length; ++copied, ++written) {
+                out[written] = out[written - offset];
+            }
+        }
+    }
+
+private:
+    static constexpr int hash_bits = 12;
+    static constexpr std::size_t min_match = 4, tail_literals = 5, max_offset = 65535;
+
+    static std::uint32_t read32(const unsigned char *bytes) {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+
+    // Token nibble, then 255-continued extra bytes when it is 15.
+    static void writeLength(std::string &out, std::size_t extra) {
+        for (; extra >= 255; extra -= 255) {
+            out.push_back(static_cast<char>(255));
+        }
+        out.push_back(static_cast<char>(extra));
+    }
+
+    static std::size_t readLength(const unsigned char *&input, const std::size_t nibble) {
+        std::size_t length = nibble;
+        if (nibble == 15) {
+            unsigned byte;
+            do {
+                byte = *input++;
+                length += byte;
+            } while (byte == 255);
+        }
+        return length;
+    }
+
+    // One sequence: literals, then (unless 'length' is 0, the final sequence) a match.
+    static void emit(std::string &out, const unsigned char *literals, const std::size_t literal_count,
+                     const std::size_t offset, const std::size_t length) {
+        const std::size_t match_code = length ? length - min_match : 0;
+        out.push_back(static_cast<char>((std::min<std::size_t>(literal_count, 15) << 4) | std::min<std::size_t>(match_code, 15)));
+        if (literal_count >= 15) {
+            writeLength(out, literal_count - 15);
+        }
+        out.append(reinterpret_cast<const char *>(literals), literal_count);
+        if (length) {
+            out.push_back(static_cast<char>(offset & 0xff));
+            out.push_back(static_cast<char>(offset >> 8));
+            if (match_code >= 15) {
+                writeLength(out, match_code - 15);
+            }
+        }
+    }
+};
+
+
+/* ======= Compressed row store ======= */
+
+// Raw rows of a file kept in memory in LZ-compressed blocks of about 64 KiB, with the dialect and header needed to
+// parse them later (see CSVParser::compressRows() and materialize()). Read rows through a Cursor: it decompresses
+// one block at a time and keeps it while the following rows are read.
+class CSVCompressedRows {
+public:
+    static constexpr std::size_t default_block_size = 64 << 10;
+
+    // Per-thread reader: decompresses the block of the requested row, unless it is the current one.
+    class Cursor {
+    public:
+        explicit Cursor(const CSVCompressedRows &store_) : store(&store_) {
+        }
+
+        [[nodiscard]] const CSVCompressedRows &source() const {
+            return *store;
+        }
+
+        // Row 'index' (0-based, empty lines excluded), valid until the cursor moves to another block.
+        // Throws std::out_of_range if 'index' is not below rows().
+        std::string_view row(const std::size_t index) {
+            if (index >= store->rows()) {
+                throw std::out_of_range(std::format("CSVCompressedRows: row {} of {}", index, store->rows()));
+            }
+            const auto block = static_cast<std::size_t>(
+                std::upper_bound(store->blocks.begin(), store->blocks.end(), index,
+                                 [](const std::size_t value, const Block &entry) { return value < entry.first_row; }) -
+                store->blocks.begin()) - 1;
+            if (block != current) {
+                load(block);
+            }
+
+            // Rows are '\n'-terminated inside the block: skip to the requested one.
+            const Block &entry = store->blocks[block];
+            const char *cursor = text.data(), *end = text.data() + text.size();
+            std::size_t skip = index - entry.first_row;
+            if (skip < last_row_in_block) {
+                last_row_in_block = 0;
+                last_position = 0;
+            }
+            cursor += last_position;
+            skip -= last_row_in_block;
+            for (; skip; --skip) {
+                cursor = CSVKernels::findStructural(cursor, end, '\n', '\n') + 1;
+            }
+            last_row_in_block = index - entry.first_row;
+            last_position = static_cast<std::size_t>(cursor - text.data());
+            return {cursor, static_cast<std::size_t>(CSVKernels::findStructural(cursor, end, '\n', '\n') - cursor)};
+        }
+
+    private:
+        void load(const std::size_t block) {
+            const Block &entry = store->blocks[block];
+            text.resize(entry.raw_size);
+            const char *source = store->data.data() + entry.offset;
+            if (entry.stored_raw) {
+                std::memcpy(text.data(), source, entry.raw_size);
+            } else {
+                CSVLZ::decompress(source, entry.raw_size, text.data());
+            }
+            current = block;
+            last_row_in_block = 0;
+            last_position = 0;
+        }
+
+        const CSVCompressedRows *store;
+        std::string text;
+        std::size_t current = std::numeric_limits<std::size_t>::max();
+        std::size_t last_row_in_block = 0, last_position = 0;   // Sequential reads resume from the previous row.
+    };
+
+    [[nodiscard]] Cursor cursor() const {
+        return Cursor(*this);
+    }
+
+    [[nodiscard]] std::size_t rows() const {
+        return row_count;
+    }
+
+    [[nodiscard]] std::size_t rawBytes() const {
+        return raw_bytes;
+    }
+
+    [[nodiscard]] std::size_t compressedBytes() const {
+        return data.size() + blocks.size() * sizeof(Block);
+    }
+
+    [[nodiscard]] char delimiter() const {
+        return dialect.delimiter;
+    }
+
+    [[nodiscard]] char quote() const {
+        return dialect.quote;
+    }
+
+    [[nodiscard]] const CSVTokenizer &tokenizer() const {
+        return dialect;
+    }
+
+    [[nodiscard]] const std::vector<std::string> &columns() const {
+        return header;
+    }
+
+    // Appends one row (without its line ending). Rows are compressed once a block is full.
+    void append(const char *begin, const char *end) {
+        pending.append(begin, end);
+        pending.push_back('\n');
+        ++pending_rows;
+        if (pending.size() >= block_size) {
+            flush();
+        }
+    }
+
+    // Compresses the rows not yet in a block.
+    void flush() {
+        if (!pending_rows) {
+            return;
+        }
+        Block block{row_count, data.size(), static_cast<std::uint32_t>(pending.size()), false};
+        CSVLZ::compress(pending.data(), pending.data() + pending.size(), data);
+        if (data.size() - block.offset >= pending.size()) {     // Incompressible: kept as is.
+            data.resize(block.offset);
+            data += pending;
+            block.stored_raw = true;
+        }
+        blocks.push_back(block);
+        row_count += pending_rows;
+        raw_bytes += pending.size();
+        pending.clear();
+        pending_rows = 0;
+    }
+
+    CSVCompressedRows(const CSVTokenizer dialect_, std::vector<std::string> header_, const std::size_t block_size_ = default_block_size)
+        : dialect(dialect_), header(std::move(header_)), block_size(block_size_) {
+    }
+
+private:
+    struct Block {
+        std::size_t first_row;
+        std::size_t offset;         // In 'data'.
+        std::uint32_t raw_size;
+        bool stored_raw;
+    };
+
+    CSVTokenizer dialect;
+    std::vector<std::string> header;
+    std::size_t block_size;
+    std::vector<Block> blocks;
+    std::string data, pending;
+    std::size_t row_count = 0, raw_bytes = 0, pending_rows = 0;
+};
+
+
+/* ======= Hardware performance counters ======= */
+
+// Counts of one stage of a parse, or of the whole parse.
+struct CSVPerfCounts {
+    std::uint64_t cycles = 0;
+    std::uint64_t instructions = 0;
+    std::uint64_t llc_misses = 0;       // Last-level cache misses.
+    std::uint64_t branch_misses = 0;
+
+    CSVPerfCounts &operator+=(const CSVPerfCounts &other) {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        llc_misses += other.llc_misses;
+        branch_misses += other.branch_misses;
+        return *this;
+    }
+
+    friend CSVPerfCounts operator-(const CSVPerfCounts &later, const CSVPerfCounts &earlier) {
+        return {later.cycles - earlier.cycles, later.instructions - earlier.instructions,
+                later.llc_misses - earlier.llc_misses, later.branch_misses - earlier.branch_misses};
+    }
+
+    // Counts scaled by 'numerator' / 'denominator' (extrapolation from sampled rows).
+    [[nodiscard]] CSVPerfCounts scaled(const std::size_t numerator, const std::size_t denominator) const {
+        const auto scale = [&](const std::uint64_t count) {
+            return denominator ? static_cast<std::uint64_t>(static_cast<double>(count) * numerator / denominator) : 0;
+        };
+        return {scale(cycles), scale(instructions), scale(llc_misses), scale(branch_misses)};
+    }
+};
+
+// Hardware counters of the last parse (see CSVParser::setPerfCounters()), user space only. 'total' covers the row loop
+// of every thread. The stages are measured on one row in 'sample_every' on average, at irregular intervals (reading the
+// counters around each stage of every row would cost more than the stages), and extrapolated to all rows.
+struct CSVPerfStats {
+    static constexpr std::size_t sample_every = 64;
+
+    bool available = false;         // False when the counters cannot be opened: not Linux, perf_event_paranoid, VM...
+    CSVPerfCounts total;
+    CSVPerfCounts tokenize;         // Splitting rows into fields.
+    CSVPerfCounts convert;          // Converting the fields and constructing the objects.
+    CSVPerfCounts insert;           // Inserting the objects (into the chunk buffer for parallel parses).
+    std::size_t sampled_rows = 0;
+
+    CSVPerfStats &operator+=(const CSVPerfStats &other) {
+        available = available || other.available;
+        total += other.total;
+        tokenize += other.tokenize;
+        convert += other.convert;
+        insert += other.insert;
+        sampled_rows += other.sampled_rows;
+        return *this;
+    }
+};
+
+// One group of counters (cycles, instructions, LLC misses, branch misses) of the calling thread, opened with
+// perf_event_open and read with a single read(). Counts are scaled up when the kernel multiplexes the group.
+// The cost of a read itself (the return from the system call disturbs the pipeline) is calibrated when the
+// counters are opened, and stage() subtracts it.
+class CSVPerfCounters {
+public:
+    CSVPerfCounters(const CSVPerfCounters &) = delete;
+    CSVPerfCounters &operator=(const CSVPerfCounters &) = delete;
+
+    // Counters of the calling thread, opened on first use; nullptr when they are not available.
+    static CSVPerfCounters *forThread() {
+#ifdef CSV_PARSER_PERF_COUNTERS
+        thread_local CSVPerfCounters counters;
+        return counters.leader >= 0 ? &counters : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
+    [[nodiscard]] CSVPerfCounts read() const {
+#ifdef CSV_PARSER_PERF_COUNTERS
+        struct {
+            std::uint64_t count, time_enabled, time_running, values[event_count];
+        } group{};
+        if (::read(leader, &group, sizeof(group)) != static_cast<ssize_t>(sizeof(group)) || !group.time_running) {
+            return {};
+        }
+        const auto scale = [&](const std::uint64_t value) {
+            return group.time_running == group.time_enabled ? value :
+                   static_cast<std::uint64_t>(static_cast<double>(value) * group.time_enabled / group.time_running);
+        };
+        return {scale(group.values[0]), scale(group.values[1]), scale(group.values[2]), scale(group.values[3])};
+#else
+        return {};
+#endif
+    }
+
+    // Counts between two reads, without the cost of the read.
+    [[nodiscard]] CSVPerfCounts stage(const CSVPerfCounts &earlier, const CSVPerfCounts &later) const {
+        const auto net = [](const std::uint64_t begin, const std::uint64_t end, const std::uint64_t cost) {
+            return end - begin > cost ? end - begin - cost : 0;
+        };
+        return {net(earlier.cycles, later.cycles, overhead.cycles), net(earlier.instructions, later.instructions, overhead.instructions),
+                net(earlier.llc_misses, later.llc_misses, overhead.llc_misses),
+                net(earlier.branch_misses, later.branch_misses, overhead.branch_misses)};
+    }
+
+#ifdef CSV_PARSER_PERF_COUNTERS
+    ~CSVPerfCounters() {
+        for (const int descriptor: descriptors) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t event_count = 4;
+
+    CSVPerfCounters() {
+        static constexpr std::uint64_t events[event_count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                              PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::size_t event = 0; event < event_count; ++event) {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = events[event];
+            attributes.disabled = event == 0;   // The leader starts the whole group.
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            descriptors[event] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, event ? descriptors[0] : -1, 0));
+            if (descriptors[event] < 0) {
+                return;     // Without every counter the group is unusable: leader stays -1.
+            }
+        }
+        ioctl(descriptors[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(descriptors[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        leader = descriptors[0];
+
+        // Smallest difference between back-to-back reads, per counter.
+        overhead = {~0ull, ~0ull, ~0ull, ~0ull};
+        for (int attempt = 0; attempt < 32; ++attempt) {
+            const CSVPerfCounts first = read(), cost = read() - first;
+            overhead = {std::min(overhead.cycles, cost.cycles), std::min(overhead.instructions, cost.instructions),
+                        std::min(overhead.llc_misses, cost.llc_misses), std::min(overhead.branch_misses, cost.branch_misses)};
+        }
+    }
+
+    int descriptors[event_count] = {-1, -1, -1, -1};
+    int leader = -1;
+#else
+private:
+    CSVPerfCounters() = default;
+#endif
+    CSVPerfCounts overhead;
+};
+
+
+/* ======= Parsing statistics ======= */
+
+// Describes the last parse of a CSVParser (see getStats()).
+struct CSVStats {
+    std::string filename;
+    std::size_t rows = 0;           // Objects produced.
+    std::uint64_t bytes = 0;        // Data bytes after the header.
+    std::size_t chunks = 1;
+    std::size_t chunk_size = 0;     // Bytes per chunk (0 when parsed on the calling thread).
+    unsigned threads = 1;           // Peak number of worker threads.
+    std::size_t steals = 0;         // Tasks stolen by idle workers (batch parsing).
+    std::size_t reused_chunks = 0;  // Chunks taken from the incremental cache instead of being parsed (see setIncremental()).
+    double seconds = 0;
+    const char *kernel = "";
+    CSVChecksum checksum_type = CSVChecksum::None;
+    std::uint64_t checksum = 0;     // Of the whole file, header included (see setChecksum()).
+    CSVPerfStats perf;              // Hardware counters (see setPerfCounters()).
+
+    // 'count' (e.g. perf.tokenize.cycles) per object produced, or per data byte.
+    [[nodiscard]] double perRow(const std::uint64_t count) const {
+        return rows ? static_cast<double>(count) / static_cast<double>(rows) : 0;
+    }
+
+    [[nodiscard]] double perByte(const std::uint64_t count) const {
+        return bytes ? static_cast<double>(count) / static_cast<double>(bytes) : 0;
+    }
+
+    // Data bytes per second of wall time, the figure to compare against a recorded baseline.
+    [[nodiscard]] double throughput() const {
+        return seconds > 0 ? static_cast<double>(bytes) / seconds : 0;
+    }
+};
+
+
+/* ======= Small-file batch result ======= */
+
+// Result of CSVParser::parseSmallFiles(): one container and one error message per file, in input order.
+template<typename Result>
+struct CSVBatchResult {
+    std::vector<Result> results;
+    std::vector<std::string> errors;    // Empty for files parsed successfully.
+    std::size_t failed = 0;
+};
+
+
+/* ======= Lint report ======= */
+
+enum class CSVLintIssue {
+    ColumnCount,        // The row has more or fewer fields than the header.
+    UnterminatedQuote,
+    InvalidValue,       // A field does not convert to the type of its column.
+    InvalidEncoding     // The row is not well-formed UTF-8 (with setValidateUTF8(true)).
+};
+
+struct CSVLintError {
+    std::uint64_t offset = 0;   // File offset of the row, or of the offending field.
+    std::size_t line = 0;       // 1-based file line.
+    std::size_t column = 0;     // 0-based field index (0 for row-level issues).
+    CSVLintIssue issue = CSVLintIssue::ColumnCount;
+    std::string message;
+};
+
+// Result of CSVParser::lintFile(). 'errors' holds the first errors in file order, 'error_count' counts all of them.
+struct CSVLintReport {
+    std::size_t rows = 0;
+    std::size_t error_count = 0;
+    std::vector<CSVLintError> errors;
+    CSVStats stats;
+
+    [[nodiscard]] bool ok() const {
+        return error_count == 0;
+    }
+};
+
+
+/* ======= Normalization options ======= */
+
+// Output dialect of CSVParser::normalizeFile(). Fields are quoted only when they contain the delimiter, the quote
+// or a line break; quotes inside them are doubled. The delimiter and the quote must differ and not be line breaks.
+struct CSVNormalizeOptions {
+    char delimiter = ',';
+    char quote = '"';
+    std::vector<std::string> columns;   // Output columns by header name, in output order. Empty: every column.
+    bool header = true;                 // Writes the header row first.
+    bool crlf = false;                  // "\r\n" line endings instead of "\n".
+};
+
+
+/* ======= Incremental parsing budget ======= */
+
+// Limits one ParseSession::step(): it returns once either the time or the row budget is used up.
+struct CSVBudget {
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::max();
+    std::size_t rows = std::numeric_limits<std::size_t>::max();
+
+    static CSVBudget forTime(const std::chrono::nanoseconds time_) {
+        return {time_, std::numeric_limits<std::size_t>::max()};
+    }
+
+    static CSVBudget forRows(const std::size_t rows_) {
+        return {std::chrono::nanoseconds::max(), rows_};
+    }
+};
+
+
+/* ======= Checkpoints ======= */
+
+// Position of a parse at a record boundary, with the dialect needed to continue it (see CSVParser::resumeFromCheckpoint()).
+struct CSVCheckpoint {
+    std::string filename;
+    std::uint64_t offset = 0;       // Byte offset of the next row.
+    std::size_t line = 0;           // Last line consumed (1-based, header included).
+    std::size_t rows = 0;           // Objects produced before the checkpoint.
+    char delimiter = ',';
+    char quote = '"';
+    int header_row = 1;
+    std::vector<std::string> header;
+    std::string delimiter_tail;     // Rest of a multi-byte delimiter.
+    char escape = '\0';
+
+    // Writes the checkpoint to a temporary file renamed over 'path', so a crash never leaves a torn checkpoint.
+    // Text values are written on one line each, with '\\', '\n' and '\r' escaped (see escapeLine()).
+    void save(const std::string &path) const {
+        const std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            out << "csv-checkpoint 3\n"
+                << "filename=" << escapeLine(filename) << "\n"
+                << "offset=" << offset << "\n"
+                << "line=" << line << "\n"
+                << "rows=" << rows << "\n"
+                << "delimiter=" << static_cast<int>(delimiter) << "\n"
+                << "quote=" << static_cast<int>(quote) << "\n"
+                << "header_row=" << header_row << "\n"
+                << "delimiter_tail=" << escapeLine(delimiter_tail) << "\n"
+                << "escape=" << static_cast<int>(escape) << "\n"
+                << "header=" << header.size() << "\n";
+            for (const auto &head: header) {
+                out << escapeLine(head) << "\n";
+            }
+            if (!out.flush()) {
+                throw InvalidCheckpoint(path, "cannot be written");
+            }
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            throw InvalidCheckpoint(path, "cannot be renamed into place");
+        }
+    }
+
+    static CSVCheckpoint load(const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        std::string line_text;
+        // Version 1 predates multi-byte delimiters and escape characters, versions 1 and 2 write text values verbatim.
+        if (!std::getline(in, line_text) || line_text.size() != 16 || !line_text.starts_with("csv-checkpoint ")
+            || line_text.back() < '1' || line_text.back() > '3') {
+            throw InvalidCheckpoint(path, "missing or unknown format");
+        }
+        const bool has_dialect_extensions = line_text.back() >= '2';
+        const bool has_escaped_text = line_text.back() >= '3';
+
+        CSVCheckpoint checkpoint;
+        auto read = [&](const std::string_view key) {
+            if (!std::getline(in, line_text) || line_text.compare(0, key.size(), key) != 0 || line_text[key.size()] != '=') {
+                throw InvalidCheckpoint(path, std::format("missing '{}'", key));
+            }
+            return line_text.substr(key.size() + 1);
+        };
+        auto text = [&](std::string value) {
+            if (has_escaped_text && !unescapeLine(value)) {
+                throw InvalidCheckpoint(path, "malformed escape sequence");
+            }
+            return value;
+        };
+
+        try {
+            checkpoint.filename = text(read("filename"));
+            checkpoint.offset = std::stoull(read("offset"));
+            checkpoint.line = std::stoull(read("line"));
+            checkpoint.rows = std::stoull(read("rows"));
+            checkpoint.delimiter = static_cast<char>(std::stoi(read("delimiter")));
+            checkpoint.quote = static_cast<char>(std::stoi(read("quote")));
+            checkpoint.header_row = std::stoi(read("header_row"));
+            if (has_dialect_extensions) {
+                checkpoint.delimiter_tail = text(read("delimiter_tail"));
+                checkpoint.escape = static_cast<char>(std::stoi(read("escape")));
+            }
+            checkpoint.header.resize(std::stoull(read("header")));
+        } catch (const std::logic_error &) {
+            throw InvalidCheckpoint(path, "malformed value");
+        }
+
+        for (auto &head: checkpoint.header) {
+            if (!std::getline(in, head)) {
+                throw InvalidCheckpoint(path, "truncated header");
+            }
+            head = text(std::move(head));
+        }
+
+        if (checkpoint.delimiter_tail.size() >= CSVTokenizer::max_delimiter_length) {
+            throw InvalidCheckpoint(path, "delimiter longer than 8 bytes");
+        }
+        const CSVTokenizer dialect = CSVTokenizer::withDelimiter(std::string(1, checkpoint.delimiter) + checkpoint.delimiter_tail,
+                                                                 checkpoint.quote, checkpoint.escape);
+        if (const char *reason = dialect.invalidReason()) {
+            throw InvalidCheckpoint(path, reason);
+        }
+        return checkpoint;
+    }
+
+private:
+    // Keeps a value on one line of the checkpoint file: '\\' -> "\\\\", '\n' -> "\\n", '\r' -> "\\r".
+    static std::string escapeLine(const std::string_view value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char symbol: value) {
+            switch (symbol) {
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                default: escaped += symbol;
+            }
+        }
+        return escaped;
+    }
+
+    // Reverses escapeLine() in place. Returns false on an unknown or incomplete escape sequence.
+    static bool unescapeLine(std::string &value) {
+        std::size_t out = 0;
+        for (std::size_t index = 0; index < value.size(); ++index, ++out) {
+            if (value[index] != '\\') {
+                value[out] = value[index];
+                continue;
+            }
+            if (++index == value.size()) {
+                return false;
+            }
+            switch (value[index]) {
+                case '\\': value[out] = '\\'; break;
+                case 'n': value[out] = '\n'; break;
+                case 'r': value[out] = '\r'; break;
+                default: return false;
+            }
+        }
+        value.resize(out);
+        return true;
+    }
+};
+
+
+/* ======= Work-stealing scheduler ======= */
+
+// Runs tasks on a fixed set of workers. Each worker pops the newest task of its own deque and, once it runs dry,
+// steals the oldest task of another worker. Tasks may queue further tasks (e.g. a large file splitting itself into chunks).
+// Worker threads are started by the first run() and kept until the pool is destroyed; idle ones sleep on a condition
+// variable instead of spinning, so the tail of a batch (one long task left) occupies one core only.
+class CSVWorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit CSVWorkStealingPool(const unsigned threads) : queues(std::max(1u, threads)) {
+    }
+
+    CSVWorkStealingPool(const CSVWorkStealingPool &) = delete;
+    CSVWorkStealingPool &operator=(const CSVWorkStealingPool &) = delete;
+
+    ~CSVWorkStealingPool() {
+        {
+            std::lock_guard lock(idle_mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto &worker: workers) {
+            worker.join();
+        }
+    }
+
+    // From inside a task, queues on the current worker's deque. Otherwise, queues round-robin.
+    void push(Task task) {
+        const std::size_t index = current_pool == this ? current_worker : next_queue++ % queues.size();
+        pending.fetch_add(1);
+        {
+            std::lock_guard lock(queues[index].mutex);
+            queues[index].tasks.push_back(std::move(task));
+        }
+        queued.fetch_add(1);
+        {
+            std::lock_guard lock(idle_mutex);   // A worker about to sleep either sees the task or gets the notification.
+        }
+        wake.notify_one();
+    }
+
+    // Runs every queued task, and the tasks they queue, then returns. The calling thread is worker 0.
+    // Rethrows the first exception thrown by a task; the remaining tasks are drained without running.
+    void run() {
+        for (auto worker = static_cast<unsigned>(workers.size()) + 1; worker < queues.size(); ++worker) {
+            workers.emplace_back(&CSVWorkStealingPool::serve, this, worker);
+        }
+
+        const CSVWorkStealingPool *previous_pool = current_pool;
+        const unsigned previous_worker = current_worker;
+        current_pool = this;
+        current_worker = 0;
+        work(0);
+        current_pool = previous_pool;
+        current_worker = previous_worker;
+
+        if (failure) {
+            std::exception_ptr error = std::exchange(failure, nullptr);
+            failure_flag.store(false);
+            std::rethrow_exception(error);
+        }
+    }
+
+    [[nodiscard]] unsigned threads() const {
+        return static_cast<unsigned>(queues.size());
+    }
+
+    // Index of the worker running the current task (0 outside of run()).
+    static unsigned currentWorker() {
+        return current_worker;
+    }
+
+    // Number of tasks taken from another worker's deque.
+    [[nodiscard]] std::size_t steals() const {
+        return steal_count.load();
+    }
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Body of the worker threads 1..n-1.
+    void serve(const unsigned worker) {
+        current_pool = this;
+        current_worker = worker;
+        work(worker);
+    }
+
+    // Worker 0 (the caller of run()) returns once every task is done; the others once the pool stops.
+    void work(const unsigned worker) {
+        while (true) {
+            Task task;
+            if (popNewest(worker, task) || stealOldest(worker, task)) {
+                if (!failure_flag.load()) {
+                    try {
+                        task();
+                    } catch (...) {
+                        std::lock_guard lock(failure_mutex);
+                        failure = failure ? failure : std::current_exception();
+                        failure_flag.store(true);
+                    }
+                }
+                if (pending.fetch_sub(1) == 1) {
+                    std::lock_guard lock(idle_mutex);
+                    wake.notify_all();
+                }
+                continue;
+            }
+
+            std::unique_lock lock(idle_mutex);
+            wake.wait(lock, [&] {
+                return queued.load() > 0 || stopping || (worker == 0 && pending.load() == 0);
+            });
+            if (stopping || (worker == 0 && pending.load() == 0)) {
+                return;
+            }
+        }
+    }
+
+    bool popNewest(const unsigned worker, Task &task) {
+        std::lock_guard lock(queues[worker].mutex);
+        if (queues[worker].tasks.empty()) {
+            return false;
+        }
+        task = std::move(queues[worker].tasks.back());
+        queues[worker].tasks.pop_back();
+        queued.fetch_sub(1);
+        return true;
+    }
+
+    bool stealOldest(const unsigned worker, Task &task) {
+        for (std::size_t step = 1; step < queues.size(); ++step) {
+            Queue &victim = queues[(worker + step) % queues.size()];
+            std::lock_guard lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                queued.fetch_sub(1);
+                steal_count.fetch_add(1);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> pending{0}, queued{0}, steal_count{0};
+    std::size_t next_queue = 0;
+
+    std::mutex idle_mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    std::mutex failure_mutex;
+    std::exception_ptr failure;
+    std::atomic<bool> failure_flag{false};
+
+    static inline thread_local const CSVWorkStealingPool *current_pool = nullptr;
+    static inline thread_local unsigned current_worker = 0;
+};
+
+
+/* ======= String arena ======= */
+
+// Chunked storage for the text of std::string_view cells and the bytes of blob cells. Blocks never move, so views
+// stay valid for the arena's lifetime (moves included), and everything is freed at once with the arena.
+class CSVStringArena {
+public:
+    static constexpr std::size_t default_block_size = 256 << 10;
+
+    CSVStringArena() : CSVStringArena(default_block_size) {
+    }
+
+    explicit CSVStringArena(const std::size_t block_size_) : block_size(block_size_) {
+    }
+
+    CSVStringArena(CSVStringArena &&) noexcept = default;
+    CSVStringArena &operator=(CSVStringArena &&) noexcept = default;
+
+    // Copies 'text' into the arena. Texts longer than a block get a block of their own.
+    std::string_view store(const std::string_view text) {
+        if (text.empty()) {
+            return {};
+        }
+        char *target = allocate(text.size());
+        std::memcpy(target, text.data(), text.size());
+        return {target, text.size()};
+    }
+
+    // Reserves 'count' uninitialized bytes (e.g. for a blob decoded in place).
+    char *allocate(const std::size_t count) {
+        if (count > capacity - used) {
+            const std::size_t size = std::max(block_size, count);
+            blocks.push_back(std::make_unique_for_overwrite<char[]>(size));
+            capacity = size;
+            used = 0;
+        }
+        char *target = blocks.back().get() + used;
+        used += count;
+        stored += count;
+        return target;
+    }
+
+    // Takes over the blocks of 'other' (e.g. the arena of a parallel chunk). Views into them remain valid.
+    void splice(CSVStringArena &&other) {
+        if (other.blocks.empty()) {
+            return;
+        }
+        // The current block stays last, so it keeps receiving texts.
+        blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), std::make_move_iterator(other.blocks.begin()),
+                      std::make_move_iterator(other.blocks.end()));
+        stored += other.stored;
+        other = CSVStringArena(other.block_size);
+    }
+
+    // Bytes of text stored.
+    [[nodiscard]] std::size_t bytes() const {
+        return stored;
+    }
+
+    [[nodiscard]] std::size_t blockCount() const {
+        return blocks.size();
+    }
+
+    // Arena receiving the std::string_view cells converted on the calling thread, nullptr outside of a Scope.
+    static CSVStringArena *current() {
+        return active;
+    }
+
+    // Makes an arena current for the calling thread until the end of the scope.
+    class Scope {
+    public:
+        explicit Scope(CSVStringArena *arena) : previous(active) {
+            active = arena;
+        }
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() {
+            active = previous;
+        }
+
+    private:
+        CSVStringArena *previous;
+    };
+
+private:
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t block_size, used = 0, capacity = 0, stored = 0;
+
+    static inline thread_local CSVStringArena *active = nullptr;
+};
+
+// Result of CSVParser::parseObjectsWithArena(): the objects and the arena their std::string_view cells point into.
+// The arena is declared first, so it is destroyed after the objects.
+template<typename Result>
+struct CSVArenaResult {
+    CSVStringArena strings;
+    Result objects;
+};
+
+
+/* ======= CSV cell conversion ======= */
+
+// Converts the text of one field into a TCell. Returns false when the text cannot be converted,
+// leaving the caller to decide the fallback value. Specialize it to support custom column types.
+template<typename TCell, typename = void>
+struct CSVCellParser {
+    static bool parse(std::string_view cell, TCell &value) {
+        if constexpr (std::is_same_v<TCell, std::string>) {
+            value.assign(cell);
+            return true;
+        } else if constexpr (std::is_same_v<TCell, bool>) {
+            cell = trim(cell);
+            if (cell.empty()) {
+                return false;
+            }
+            const char lower = static_cast<char>(std::tolower(static_cast<unsigned char>(cell.front())));
+            value = (lower == 'y' || lower == 't' || lower == '1');
+            return true;
+        } else if constexpr (std::is_same_v<TCell, char>) {
+            cell = trim(cell);
+            if (cell.empty()) {
+                return false;
+            }
+            value = cell.front();
+            return true;
+        } else if constexpr (std::is_integral_v<TCell>) {
+            return parseInteger(trim(cell), value);
+        } else if constexpr (std::is_floating_point_v<TCell>) {
+            cell = trim(cell);
+            if (!cell.empty() && cell.front() == '+') {
+                cell.remove_prefix(1);
+            }
+            // The whole cell must be the number: "1.5x" fails instead of converting to 1.5.
+            const auto [end, error] = std::from_chars(cell.data(), cell.data() + cell.size(), value);
+            return error == std::errc{} && end == cell.data() + cell.size();
+        } else {
+            std::istringstream iss{std::string(cell)};
+            iss >> value;
+            return !iss.fail();
+        }
+    }
+
+    // Strips the spaces and tabs around a cell: "12 " and " 3.5\t" convert, "12abc" does not.
+    static std::string_view trim(std::string_view cell) {
+        while (!cell.empty() && (cell.front() == ' ' || cell.front() == '\t')) {
+            cell.remove_prefix(1);
+        }
+        while (!cell.empty() && (cell.back() == ' ' || cell.back() == '\t')) {
+            cell.remove_suffix(1);
+        }
+        return cell;
+    }
+
+private:
+    // Short digit runs are accumulated directly; longer ones (possible overflow) go through from_chars.
+    // Like floating-point cells, the digits must reach the end of the trimmed cell ("12abc" fails).
+    static bool parseInteger(std::string_view cell, TCell &value) {
+        const char *it = cell.data(), *end = cell.data() + cell.size();
+        bool negative = false;
+        if (it < end && (*it == '-' || *it == '+')) {
+            negative = (*it == '-');
+            ++it;
+        }
+
+        const std::size_t digits = CSVKernels::countDigits(it, end);
+        if (digits == 0 || it + digits != end || (negative && std::is_unsigned_v<TCell>)) {
+            return false;
+        }
+
+        if (digits > 18) {
+            return std::from_chars(negative ? it - 1 : it, it + digits, value).ec == std::errc{};
+        }
+
+        std::uint64_t magnitude = 0;
+        for (const char *digit = it; digit < it + digits; ++digit) {
+            magnitude = magnitude * 10 + static_cast<std::uint64_t>(*digit - '0');
+        }
+
+        if (negative) {
+            const auto limit = static_cast<std::uint64_t>(-(static_cast<std::int64_t>(std::numeric_limits<TCell>::min()) + 1)) + 1;
+            if (magnitude > limit) {
+                return false;
+            }
+            value = static_cast<TCell>(-static_cast<std::int64_t>(magnitude));
+        } else {
+            if (magnitude > static_cast<std::uint64_t>(std::numeric_limits<TCell>::max())) {
+                return false;
+            }
+            value = static_cast<TCell>(magnitude);
+        }
+        return true;
+    }
+};
+
+
+// std::string_view cells are copied into the current CSVStringArena (see CSVParser::parseObjectsWithArena()).
+// Without one, there is no storage outliving the row buffer: the conversion fails and the cell is left empty.
+template<>
+struct CSVCellParser<std::string_view> {
+    static bool parse(const std::string_view cell, std::string_view &value) {
+        CSVStringArena *arena = CSVStringArena::current();
+        if (!arena) {
+            return false;
+        }
+        value = arena->store(cell);
+        return true;
+    }
+};
+
+
+/* ======= Decimal columns ======= */
+
+#ifdef __SIZEOF_INT128__
+#define CSV_PARSER_MAX_DECIMAL_PRECISION 38
+#else
+#define CSV_PARSER_MAX_DECIMAL_PRECISION 18
+#endif
+
+// Fixed-point decimal of up to 'Precision' significant digits, 'Scale' of them after the point, stored as a scaled
+// integer (int64 up to 18 digits, int128 beyond). Parsed straight from the digits: no floating point is involved.
+// Values beyond Precision digits fail to convert; extra fraction digits are rounded half away from zero.
+template<unsigned Precision, unsigned Scale>
+    requires(Precision > 0 && Scale <= Precision && Precision <= CSV_PARSER_MAX_DECIMAL_PRECISION)
+class CSVDecimal {
+public:
+#ifdef __SIZEOF_INT128__
+    // __extension__: the header stays quiet under -Wpedantic, which flags __int128 as non-ISO.
+    __extension__ typedef std::conditional_t<(Precision <= 18), std::int64_t, __int128> Raw;
+#else
+    using Raw = std::int64_t;
+#endif
+
+    static constexpr unsigned precision = Precision, scale = Scale;
+
+    constexpr CSVDecimal() = default;
+
+    // The decimal 'raw' / 10^Scale.
+    static constexpr CSVDecimal fromRaw(const Raw raw) {
+        CSVDecimal decimal;
+        decimal.value = raw;
+        return decimal;
+    }
+
+    [[nodiscard]] constexpr Raw raw() const {
+        return value;
+    }
+
+    // Accepts [spaces][+|-]digits[.digits]. Returns false on any other text or on overflow.
+    static constexpr bool parse(std::string_view text, CSVDecimal &decimal) {
+        while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+            text.remove_prefix(1);
+        }
+        const bool negative = !text.empty() && text.front() == '-';
+        if (!text.empty() && (text.front() == '-' || text.front() == '+')) {
+            text.remove_prefix(1);
+        }
+
+        Raw raw = 0;
+        std::size_t position = 0, digits = 0;
+        unsigned fraction_digits = 0;
+        // Checked before multiplying: with 38 digits, 10 * raw may not fit in int128.
+        auto push = [&](const char digit) {
+            if (raw > (limit - 1 - (digit - '0')) / 10) {
+                return false;
+            }
+            raw = raw * 10 + (digit - '0');
+            return true;
+        };
+
+        for (; position < text.size() && isDigit(text[position]); ++position, ++digits) {
+            if (!push(text[position])) {
+                return false;
+            }
+        }
+        if (position < text.size() && text[position] == '.') {
+            for (++position; position < text.size() && isDigit(text[position]); ++position, ++digits) {
+                if (fraction_digits < Scale) {
+                    if (!push(text[position])) {
+                        return false;
+                    }
+                    ++fraction_digits;
+                } else if (fraction_digits == Scale) {
+                    // First dropped digit: rounds half away from zero; the following ones are only validated.
+                    if (text[position] >= '5' && (raw += 1) >= limit) {
+                        return false;
+                    }
+                    ++fraction_digits;
+                }
+            }
+        }
+        if (!digits || position != text.size()) {
+            return false;
+        }
+        for (; fraction_digits < Scale; ++fraction_digits) {
+            if (!push('0')) {
+                return false;
+            }
+        }
+
+        decimal.value = negative ? -raw : raw;
+        return true;
+    }
+
+    [[nodiscard]] std::string toString() const {
+        std::string digits;
+        Raw magnitude = value < 0 ? -value : value;
+        do {
+            digits.push_back(static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+            magnitude /= 10;
+        } while (magnitude);
+        while (digits.size() <= Scale) {
+            digits.push_back('0');
+        }
+        if (Scale) {
+            digits.insert(digits.begin() + Scale, '.');
+        }
+        if (value < 0) {
+            digits.push_back('-');
+        }
+        return {digits.rbegin(), digits.rend()};
+    }
+
+    [[nodiscard]] double toDouble() const {
+        return static_cast<double>(value) / static_cast<double>(pow10(Scale));
+    }
+
+    constexpr auto operator<=>(const CSVDecimal &) const = default;
+
+    // Aggregation: sums and differences keep the scale; results beyond Precision digits throw std::overflow_error.
+    constexpr CSVDecimal &operator+=(const CSVDecimal &other) {
+        value = checkedSum(value, other.value);
+        return *this;
+    }
+
+    constexpr CSVDecimal &operator-=(const CSVDecimal &other) {
+        value = checkedSum(value, -other.value);
+        return *this;
+    }
+
+    friend constexpr CSVDecimal operator+(CSVDecimal left, const CSVDecimal &right) {
+        return left += right;
+    }
+
+    friend constexpr CSVDecimal operator-(CSVDecimal left, const CSVDecimal &right) {
+        return left -= right;
+    }
+
+    constexpr CSVDecimal operator-() const {
+        return fromRaw(-value);
+    }
+
+    friend std::ostream &operator<<(std::ostream &stream, const CSVDecimal &decimal) {
+        return stream << decimal.toString();
+    }
+
+private:
+    static constexpr Raw pow10(const unsigned exponent) {
+        Raw result = 1;
+        for (unsigned step = 0; step < exponent; ++step) {
+            result *= 10;
+        }
+        return result;
+    }
+
+    static constexpr bool isDigit(const char symbol) {
+        return symbol >= '0' && symbol <= '9';
+    }
+
+    // Operands are below 10^Precision: the bound is checked before adding, as 2 * 10^38 does not fit in int128.
+    static constexpr Raw checkedSum(const Raw left, const Raw right) {
+        if (right > 0 ? left > limit - 1 - right : left < -(limit - 1) - right) {
+            throw std::overflow_error(std::format("CSVDecimal<{}, {}> overflow.", Precision, Scale));
+        }
+        return left + right;
+    }
+
+    static constexpr Raw limit = pow10(Precision);
+
+    Raw value = 0;
+};
+
+template<typename>
+struct is_csv_decimal : std::false_type {};
+
+template<unsigned Precision, unsigned Scale>
+struct is_csv_decimal<CSVDecimal<Precision, Scale>> : std::true_type {};
+
+template<typename T>
+concept CSVDecimalColumn = is_csv_decimal<T>::value;
+
+template<typename TDecimal>
+struct CSVCellParser<TDecimal, std::enable_if_t<CSVDecimalColumn<TDecimal>>> {
+    static bool parse(const std::string_view cell, TDecimal &value) {
+        return TDecimal::parse(CSVCellParser<std::string>::trim(cell), value);
+    }
+};
+
+
+/* ======= Enum columns ======= */
+
+// Declares the text of each value of an enum column. Specialize it for TEnum with
+//     static constexpr std::array<std::pair<std::string_view, TEnum>, N> values{{{"ACTIVE", Status::Active}, ...}};
+// and optionally 'static constexpr TEnum fallback = ...;' for unknown texts (without it, unknown texts fail to
+// convert: the cell is value-initialized and lintFile() reports it).
+template<typename TEnum>
+struct CSVEnumTraits;
+
+template<typename TEnum>
+concept CSVEnumColumn = std::is_enum_v<TEnum> && requires { CSVEnumTraits<TEnum>::values; };
+
+// Perfect hash of the texts of CSVEnumTraits<TEnum>, built at compile time: a seed is searched so that every text
+// lands in its own slot. A lookup is one hash of the field and one comparison with the text of its slot.
+template<CSVEnumColumn TEnum>
+class CSVEnumTable {
+    static constexpr auto &values = CSVEnumTraits<TEnum>::values;
+    static constexpr std::size_t count = std::size(values);
+    static_assert(count > 0 && count <= 256, "CSVEnumTraits: between 1 and 256 values are supported.");
+
+    // About count^2 slots: a collision-free seed is found within a few tries.
+    static constexpr std::size_t slot_count = std::bit_ceil(std::max<std::size_t>(count * count, 8));
+
+public:
+    static constexpr bool lookup(const std::string_view text, TEnum &value) {
+        const std::int16_t index = layout.slots[hash(text, layout.seed) & (slot_count - 1)];
+        if (index < 0 || values[index].first != text) {
+            return false;
+        }
+        value = values[index].second;
+        return true;
+    }
+
+private:
+    struct Layout {
+        std::uint64_t seed = 0;
+        std::array<std::int16_t, slot_count> slots{};
+    };
+
+    // FNV-1a over the seed and the text.
+    static constexpr std::uint64_t hash(const std::string_view text, const std::uint64_t seed) {
+        std::uint64_t state = 0xcbf29ce484222325ull ^ seed;
+        for (const char symbol: text) {
+            state = (state ^ static_cast<unsigned char>(symbol)) * 0x100000001b3ull;
+        }
+        return state ^ (state >> 29);
+    }
+
+    static constexpr Layout build() {
+        for (std::uint64_t seed = 0;; ++seed) {
+            Layout candidate{seed, {}};
+            candidate.slots.fill(-1);
+            bool collision = false;
+            for (std::size_t index = 0; index < count && !collision; ++index) {
+                std::int16_t &slot = candidate.slots[hash(values[index].first, seed) & (slot_count - 1)];
+                collision = slot >= 0;
+                slot = static_cast<std::int16_t>(index);
+            }
+            if (!collision) {
+                return candidate;
+            }
+        }
+    }
+
+    static constexpr Layout layout = build();
+};
+
+template<typename TEnum>
+struct CSVCellParser<TEnum, std::enable_if_t<CSVEnumColumn<TEnum>>> {
+    static bool parse(const std::string_view cell, TEnum &value) {
+        if (CSVEnumTable<TEnum>::lookup(CSVCellParser<std::string>::trim(cell), value)) {
+            return true;
+        }
+        if constexpr (requires { CSVEnumTraits<TEnum>::fallback; }) {
+            value = CSVEnumTraits<TEnum>::fallback;
+            return true;
+        } else {
+            return false;
+        }
+    }
+};
+
+
+/* ======= UUID and IP address columns ======= */
+
+// 128-bit identifier read from its 36-character form (8-4-4-4-12 hex digits, either case). The 38-character form in
+// braces and the 32 digits without dashes are also accepted. Stored as 16 bytes in text order: comparisons follow the
+// text, and hashing reads two 64-bit words instead of 36 characters.
+class CSVUUID {
+public:
+    constexpr CSVUUID() = default;
+
+    static constexpr CSVUUID fromBytes(const std::array<std::uint8_t, 16> &bytes_) {
+        CSVUUID uuid;
+        uuid.value = bytes_;
+        return uuid;
+    }
+
+    [[nodiscard]] constexpr const std::array<std::uint8_t, 16> &bytes() const {
+        return value;
+    }
+
+    // The dashes are dropped with five copies; the 32 digits are decoded by the vectorized hex kernel.
+    static bool parse(std::string_view text, CSVUUID &uuid) {
+        if (text.size() == 38 && text.front() == '{' && text.back() == '}') {
+            text = text.substr(1, 36);
+        }
+        char digits[32];
+        const char *source = text.data();
+        if (text.size() == 36) {
+            if (text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-') {
+                return false;
+            }
+            std::memcpy(digits, source, 8);
+            std::memcpy(digits + 8, source + 9, 4);
+            std::memcpy(digits + 12, source + 14, 4);
+            std::memcpy(digits + 16, source + 19, 4);
+            std::memcpy(digits + 20, source + 24, 12);
+            source = digits;
+        } else if (text.size() != 32) {
+            return false;
+        }
+        return CSVKernels::decodeHex(source, source + 32, uuid.value.data());
+    }
+
+    // Lower-case 8-4-4-4-12 form.
+    [[nodiscard]] std::string toString() const {
+        static constexpr char digits[] = "0123456789abcdef";
+        std::string text;
+        text.reserve(36);
+        for (std::size_t index = 0; index < 16; ++index) {
+            if (index == 4 || index == 6 || index == 8 || index == 10) {
+                text.push_back('-');
+            }
+            text.push_back(digits[value[index] >> 4]);
+            text.push_back(digits[value[index] & 0x0F]);
+        }
+        return text;
+    }
+
+    [[nodiscard]] std::size_t hash() const {
+        std::uint64_t words[2];
+        std::memcpy(words, value.data(), sizeof(words));
+        const std::uint64_t mixed = (words[0] ^ (words[1] * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+        return static_cast<std::size_t>(mixed ^ (mixed >> 31));
+    }
+
+    constexpr bool operator==(const CSVUUID &) const = default;
+    constexpr auto operator<=>(const CSVUUID &) const = default;
+
+    friend std::ostream &operator<<(std::ostream &stream, const CSVUUID &uuid) {
+        return stream << uuid.toString();
+    }
+
+private:
+    std::array<std::uint8_t, 16> value{};
+};
+
+// IPv4 or IPv6 address in 16 bytes (network order). IPv4 addresses are stored IPv4-mapped (::ffff:a.b.c.d), so both
+// families share one column, one ordering and one hash. Accepts dotted quads (no leading zeros) and RFC 4291 text:
+// '::' compression and an embedded dotted quad in the last 32 bits. Zone indices ('%eth0') are rejected.
+class CSVIPAddress {
+public:
+    constexpr CSVIPAddress() = default;
+
+    static constexpr CSVIPAddress fromBytes(const std::array<std::uint8_t, 16> &bytes_) {
+        CSVIPAddress address;
+        address.value = bytes_;
+        return address;
+    }
+
+    // 'ipv4' in host order, e.g. 0x7F000001 for 127.0.0.1.
+    static constexpr CSVIPAddress fromV4(const std::uint32_t ipv4) {
+        CSVIPAddress address;
+        address.value[10] = address.value[11] = 0xFF;
+        for (std::size_t index = 0; index < 4; ++index) {
+            address.value[12 + index] = static_cast<std::uint8_t>(ipv4 >> (24 - 8 * index));
+        }
+        return address;
+    }
+
+    [[nodiscard]] constexpr const std::array<std::uint8_t, 16> &bytes() const {
+        return value;
+    }
+
+    [[nodiscard]] constexpr bool isV4() const {
+        for (std::size_t index = 0; index < 10; ++index) {
+            if (value[index]) {
+                return false;
+            }
+        }
+        return value[10] == 0xFF && value[11] == 0xFF;
+    }
+
+    // The IPv4 address in host order (meaningful when isV4()).
+    [[nodiscard]] constexpr std::uint32_t v4() const {
+        return static_cast<std::uint32_t>(value[12]) << 24 | static_cast<std::uint32_t>(value[13]) << 16 |
+               static_cast<std::uint32_t>(value[14]) << 8 | value[15];
+    }
+
+    static constexpr bool parse(const std::string_view text, CSVIPAddress &address) {
+        CSVIPAddress parsed;
+        if (text.find(':') == std::string_view::npos) {
+            parsed.value[10] = parsed.value[11] = 0xFF;
+            if (!parseV4(text, parsed.value.data() + 12)) {
+                return false;
+            }
+        } else if (!parseV6(text, parsed.value)) {
+            return false;
+        }
+        address = parsed;
+        return true;
+    }
+
+    // Dotted quad for IPv4 (and IPv4-mapped) addresses, RFC 5952 form otherwise: lower case, the longest run of two or
+    // more zero groups compressed to '::'.
+    [[nodiscard]] std::string toString() const {
+        if (isV4()) {
+            return std::format("{}.{}.{}.{}", unsigned{value[12]}, unsigned{value[13]}, unsigned{value[14]}, unsigned{value[15]});
+        }
+
+        std::uint16_t groups[8];
+        for (std::size_t group = 0; group < 8; ++group) {
+            groups[group] = static_cast<std::uint16_t>(value[2 * group] << 8 | value[2 * group + 1]);
+        }
+        std::size_t gap = 8, gap_length = 1;
+        for (std::size_t group = 0; group < 8;) {
+            std::size_t run = 0;
+            while (group + run < 8 && groups[group + run] == 0) {
+                ++run;
+            }
+            if (run > gap_length) {
+                gap = group;
+                gap_length = run;
+            }
+            group += run ? run : 1;
+        }
+
+        std::string text;
+        for (std::size_t group = 0; group < 8; ++group) {
+            if (group == gap) {
+                text += "::";
+                group += gap_length - 1;
+                continue;
+            }
+            if (!text.empty() && text.back() != ':') {
+                text.push_back(':');
+            }
+            char digits[4];
+            text.append(digits, std::to_chars(digits, digits + 4, groups[group], 16).ptr);
+        }
+        return text;
+    }
+
+    [[nodiscard]] std::size_t hash() const {
+        std::uint64_t words[2];
+        std::memcpy(words, value.data(), sizeof(words));
+        const std::uint64_t mixed = (words[0] ^ (words[1] * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+        return static_cast<std::size_t>(mixed ^ (mixed >> 31));
+    }
+
+    constexpr bool operator==(const CSVIPAddress &) const = default;
+    constexpr auto operator<=>(const CSVIPAddress &) const = default;
+
+    friend std::ostream &operator<<(std::ostream &stream, const CSVIPAddress &address) {
+        return stream << address.toString();
+    }
+
+private:
+    // Four decimal octets of 1 to 3 digits, each at most 255, separated by dots.
+    static constexpr bool parseV4(const std::string_view text, std::uint8_t *octets) {
+        std::size_t position = 0;
+        for (std::size_t octet = 0; octet < 4; ++octet) {
+            if (octet && (position >= text.size() || text[position++] != '.')) {
+                return false;
+            }
+            unsigned number = 0;
+            std::size_t digits = 0;
+            for (; position < text.size() && text[position] >= '0' && text[position] <= '9' && digits < 4; ++position, ++digits) {
+                number = number * 10 + static_cast<unsigned>(text[position] - '0');
+            }
+            if (digits == 0 || digits > 3 || number > 255 || (digits > 1 && text[position - digits] == '0')) {
+                return false;
+            }
+            octets[octet] = static_cast<std::uint8_t>(number);
+        }
+        return position == text.size();
+    }
+
+    static constexpr int hexDigit(const char symbol) {
+        if (symbol >= '0' && symbol <= '9') {
+            return symbol - '0';
+        }
+        const char lower = static_cast<char>(symbol | 0x20);
+        return lower >= 'a' && lower <= 'f' ? lower - 'a' + 10 : -1;
+    }
+
+    // Up to eight groups of 1 to 4 hex digits; one '::' stands for one or more zero groups.
+    static constexpr bool parseV6(const std::string_view text, std::array<std::uint8_t, 16> &bytes_) {
+        std::uint8_t parsed[16]{};
+        std::size_t count = 0, position = 0;    // 'count' bytes written so far.
+        std::size_t gap = 16;                   // Byte index of the '::', if any.
+
+        if (text.starts_with("::")) {
+            gap = 0;
+            position = 2;
+        } else if (text.starts_with(":")) {
+            return false;
+        }
+
+        while (position < text.size()) {
+            const std::size_t end = std::min(text.find(':', position), text.size());
+            const std::string_view part = text.substr(position, end - position);
+            if (part.find('.') != std::string_view::npos) {
+                // Embedded IPv4: the last 32 bits.
+                if (end != text.size() || count > 12 || !parseV4(part, parsed + count)) {
+                    return false;
+                }
+                count += 4;
+                position = end;
+                break;
+            }
+            if (part.empty() || part.size() > 4 || count == 16) {
+                return false;
+            }
+            int group = 0;
+            for (const char symbol: part) {
+                const int digit = hexDigit(symbol);
+                if (digit < 0) {
+                    return false;
+                }
+                group = group << 4 | digit;
+            }
+            parsed[count++] = static_cast<std::uint8_t>(group >> 8);
+            parsed[count++] = static_cast<std::uint8_t>(group);
+
+            position = end;
+            if (position == text.size()) {
+                break;
+            }
+            if (position + 1 < text.size() && text[position + 1] == ':') {
+                // A second '::', or one after eight groups (it must stand for at least one zero group).
+                if (gap != 16 || count == 16) {
+                    return false;
+                }
+                gap = count;
+                position += 2;
+            } else if (++position == text.size()) {
+                return false;
+            }
+        }
+
+        if (gap == 16) {
+            if (count != 16) {
+                return false;
+            }
+            std::copy_n(parsed, 16, bytes_.begin());
+            return true;
+        }
+        if (count > 14) {
+            return false;
+        }
+        bytes_.fill(0);
+        std::copy_n(parsed, gap, bytes_.begin());
+        std::copy_n(parsed + gap, count - gap, bytes_.begin() + static_cast<std::ptrdiff_t>(16 - (count - gap)));
+        return true;
+    }
+
+    std::array<std::uint8_t, 16> value{};
+};
+
+template<>
+struct std::hash<CSVUUID> {
+    std::size_t operator()(const CSVUUID &uuid) const noexcept {
+        return uuid.hash();
+    }
+};
+
+template<>
+struct std::hash<CSVIPAddress> {
+    std::size_t operator()(const CSVIPAddress &address) const noexcept {
+        return address.hash();
+    }
+};
+
+// 16-byte binary key columns: stored and exported as fixed-size binary.
+template<typename T>
+concept CSVBinaryKeyColumn = std::is_same_v<T, CSVUUID> || std::is_same_v<T, CSVIPAddress>;
+
+template<typename TKey>
+struct CSVCellParser<TKey, std::enable_if_t<CSVBinaryKeyColumn<TKey>>> {
+    static bool parse(const std::string_view cell, TKey &value) {
+        return TKey::parse(CSVCellParser<std::string>::trim(cell), value);
+    }
+};
+
+
+/* ======= Binary blob columns ======= */
+
+enum class CSVBlobEncoding { Hex, Base64 };
+
+// Binary payload of a hex or base64 field (standard alphabet, '=' padding optional), decoded by the vectorized kernels
+// straight from the field bytes. Under parseObjectsWithArena() the bytes are written into the result's arena and the
+// blob is a view; otherwise it shares ownership of a buffer of its own, so copies never duplicate the bytes.
+template<CSVBlobEncoding Encoding>
+class CSVBlob {
+public:
+    static constexpr CSVBlobEncoding encoding = Encoding;
+    static constexpr std::size_t invalid_size = static_cast<std::size_t>(-1);
+
+    CSVBlob() = default;
+
+    [[nodiscard]] const std::uint8_t *data() const {
+        return begin;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return length;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return length == 0;
+    }
+
+    [[nodiscard]] std::span<const std::uint8_t> bytes() const {
+        return {begin, length};
+    }
+
+    // Number of bytes 'text' decodes to, or invalid_size if its length cannot be a valid encoding.
+    static std::size_t decodedSize(const std::string_view text) {
+        if constexpr (Encoding == CSVBlobEncoding::Hex) {
+            return text.size() % 2 ? invalid_size : text.size() / 2;
+        } else {
+            const std::size_t digits = base64Digits(text);
+            return digits % 4 == 1 ? invalid_size : digits / 4 * 3 + (digits % 4 ? digits % 4 - 1 : 0);
+        }
+    }
+
+    // Decodes 'text' into decodedSize(text) bytes at 'out'. Returns false on a byte outside the alphabet.
+    static bool decode(const std::string_view text, std::uint8_t *out) {
+        if constexpr (Encoding == CSVBlobEncoding::Hex) {
+            return CSVKernels::decodeHex(text.data(), text.data() + text.size(), out);
+        } else {
+            const std::size_t digits = base64Digits(text), whole = digits / 4 * 4;
+            if (!CSVKernels::decodeBase64(text.data(), text.data() + whole, out)) {
+                return false;
+            }
+            // A final group of 2 or 3 digits holds 1 or 2 bytes.
+            std::uint32_t group = 0;
+            for (std::size_t index = whole; index < digits; ++index) {
+                const std::uint8_t sextet = CSVKernels::base64Value(text[index]);
+                if (sextet > 63) {
+                    return false;
+                }
+                group = group << 6 | sextet;
+            }
+            out += whole / 4 * 3;
+            if (digits - whole == 2) {
+                out[0] = static_cast<std::uint8_t>(group >> 4);
+            } else if (digits - whole == 3) {
+                out[0] = static_cast<std::uint8_t>(group >> 10);
+                out[1] = static_cast<std::uint8_t>(group >> 2);
+            }
+            return true;
+        }
+    }
+
+    static bool parse(const std::string_view text, CSVBlob &blob) {
+        const std::size_t size = decodedSize(text);
+        if (size == invalid_size) {
+            return false;
+        }
+        CSVBlob decoded;
+        if (size) {
+            std::uint8_t *target;
+            if (CSVStringArena *arena = CSVStringArena::current()) {
+                target = reinterpret_cast<std::uint8_t *>(arena->allocate(size));
+            } else {
+                auto buffer = std::make_shared_for_overwrite<std::uint8_t[]>(size);
+                target = buffer.get();
+                decoded.owner = std::move(buffer);
+            }
+            if (!decode(text, target)) {
+                return false;
+            }
+            decoded.begin = target;
+            decoded.length = size;
+        }
+        blob = std::move(decoded);
+        return true;
+    }
+
+    bool operator==(const CSVBlob &other) const {
+        return std::ranges::equal(bytes(), other.bytes());
+    }
+
+private:
+    // Length of 'text' without its '=' padding (at most two, and only on a whole number of quartets).
+    static std::size_t base64Digits(const std::string_view text) {
+        std::size_t digits = text.size();
+        if (digits % 4 == 0) {
+            for (int pad = 0; pad < 2 && digits && text[digits - 1] == '='; ++pad) {
+                --digits;
+            }
+        }
+        return digits;
+    }
+
+    std::shared_ptr<const std::uint8_t[]> owner;    // Null when the bytes are in an arena.
+    const std::uint8_t *begin = nullptr;
+    std::size_t length = 0;
+};
+
+template<typename>
+struct is_csv_blob : std::false_type {};
+
+template<CSVBlobEncoding Encoding>
+struct is_csv_blob<CSVBlob<Encoding>> : std::true_type {};
+
+template<typename T>
+concept CSVBlobColumn = is_csv_blob<T>::value;
+
+template<typename TBlob>
+struct CSVCellParser<TBlob, std::enable_if_t<CSVBlobColumn<TBlob>>> {
+    static bool parse(const std::string_view cell, TBlob &value) {
+        return TBlob::parse(cell, value);
+    }
+};
+
+
+/* ======= Shared-memory dataset ======= */
+
+#ifdef CSV_PARSER_POSIX
+
+// Column types a shared dataset can store: arithmetic, decimal and 16-byte key values in flat arrays, strings as
+// offsets into one text block.
+template<typename T>
+concept CSVSharedColumn = std::is_arithmetic_v<T> || std::is_same_v<T, std::string> || CSVDecimalColumn<T> ||
+                          CSVBinaryKeyColumn<T>;
+
+// Read-only, position-independent table of parsed rows, one typed column per CSV column, in a POSIX shared memory
+// object ('/name') or in a file (any other path) mapped by every process attaching it. It holds offsets only, so
+// processes may map it at any address. Built by CSVParser::publishDataset(); attaching costs one mmap().
+//
+// Layout: Header, 'Columns' offsets, then each column aligned to 64 bytes. An arithmetic column is an array of 'rows'
+// values (bool stored as one byte); a string column is 'rows + 1' 64-bit offsets followed by the text.
+template<typename... Columns>
+class CSVSharedDataset {
+    // Element type of an arithmetic column (bool is stored as one byte).
+    template<typename TCell>
+    using Stored = std::conditional_t<std::is_same_v<TCell, bool>, std::uint8_t, TCell>;
+
+public:
+    CSVSharedDataset(const CSVSharedDataset &) = delete;
+    CSVSharedDataset &operator=(const CSVSharedDataset &) = delete;
+
+    CSVSharedDataset(CSVSharedDataset &&other) noexcept
+        : base(std::exchange(other.base, nullptr)), size(std::exchange(other.size, 0)) {
+    }
+
+    CSVSharedDataset &operator=(CSVSharedDataset &&other) noexcept {
+        if (this != &other) {
+            unmap();
+            base = std::exchange(other.base, nullptr);
+            size = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    ~CSVSharedDataset() {
+        unmap();
+    }
+
+    // Maps a published dataset read-only. Throws InvalidDataset if it is missing, incomplete, corrupt or of other
+    // column types.
+    static CSVSharedDataset attach(const std::string &name) {
+        const int descriptor = openObject(name, O_RDONLY, 0);
+        if (descriptor < 0) {
+            throw InvalidDataset(name, "cannot be opened");
+        }
+        struct stat status{};
+        if (fstat(descriptor, &status) != 0) {
+            close(descriptor);
+            throw InvalidDataset(name, "cannot be read");
+        }
+        const auto length = static_cast<std::size_t>(status.st_size);
+        void *mapping = length >= sizeof(Header) + sizeof(std::uint64_t) * sizeof...(Columns) ? mmap(nullptr, length, PROT_READ, MAP_SHARED, descriptor, 0) : MAP_FAILED;
+        close(descriptor);
+        if (mapping == MAP_FAILED) {
+            throw InvalidDataset(name, "cannot be mapped");
+        }
+
+        CSVSharedDataset dataset(static_cast<const std::byte *>(mapping), length);
+        const Header &header = dataset.header();
+        if (std::atomic_ref(const_cast<std::uint64_t &>(header.magic)).load(std::memory_order_acquire) != magic ||
+            header.size != length) {
+            throw InvalidDataset(name, "is not a complete dataset");
+        }
+        if (header.columns != sizeof...(Columns) || header.signature != signature()) {
+            throw InvalidDataset(name, "column types differ");
+        }
+        // get() and column() trust the offsets of the mapping: a truncated or corrupt one is rejected here.
+        if (!dataset.columnsInBounds(std::index_sequence_for<Columns...>{})) {
+            throw InvalidDataset(name, "has columns outside of its bounds");
+        }
+        return dataset;
+    }
+
+    // Deletes the shared memory object or file. Processes already attached keep their mapping.
+    static bool remove(const std::string &name) {
+        return (isSharedMemoryName(name) ? shm_unlink(name.c_str()) : unlink(name.c_str())) == 0;
+    }
+
+    [[nodiscard]] std::size_t rows() const {
+        return static_cast<std::size_t>(header().rows);
+    }
+
+    // Value of column 'Column' at 'row': a string_view into the dataset for strings, the value otherwise.
+    template<std::size_t Column>
+    [[nodiscard]] auto get(const std::size_t row) const {
+        using TCell = std::tuple_element_t<Column, std::tuple<Columns...>>;
+        if constexpr (std::is_same_v<TCell, std::string>) {
+            const auto *offsets = reinterpret_cast<const std::uint64_t *>(base + columnOffset(Column));
+            const auto *text = reinterpret_cast<const char *>(offsets + rows() + 1);
+            return std::string_view(text + offsets[row], static_cast<std::size_t>(offsets[row + 1] - offsets[row]));
+        } else {
+            return static_cast<TCell>(reinterpret_cast<const Stored<TCell> *>(base + columnOffset(Column))[row]);
+        }
+    }
+
+    // Whole arithmetic column, for scans without touching the other columns.
+    template<std::size_t Column>
+        requires std::is_arithmetic_v<std::tuple_element_t<Column, std::tuple<Columns...>>>
+    [[nodiscard]] auto column() const {
+        using TStored = Stored<std::tuple_element_t<Column, std::tuple<Columns...>>>;
+        return std::span<const TStored>(reinterpret_cast<const TStored *>(base + columnOffset(Column)), rows());
+    }
+
+    // Constructs the object of 'row' (strings are copied out of the dataset).
+    template<typename TObject>
+    [[nodiscard]] TObject object(const std::size_t row) const {
+        return objectAt<TObject>(row, std::index_sequence_for<Columns...>{});
+    }
+
+    // Collects the cells of one column while a file is parsed, then writes the dataset.
+    class Builder {
+    public:
+        // Converts the fields of one row as CSVParser does: missing or unconvertible fields are value-initialized.
+        void append(const std::vector<std::string_view> &fields) {
+            appendCells(fields, std::index_sequence_for<Columns...>{});
+            ++row_count;
+        }
+
+        // Writes the dataset under 'name', replacing an existing one. Readers attached to the previous dataset
+        // keep it; new readers only see the new one once it is complete.
+        void publish(const std::string &name) const;
+
+    private:
+        template<std::size_t... Index>
+        void appendCells(const std::vector<std::string_view> &fields, std::index_sequence<Index...>) {
+            (appendCell<Index>(fields), ...);
+        }
+
+        template<std::size_t Index>
+        void appendCell(const std::vector<std::string_view> &fields) {
+            using TCell = std::tuple_element_t<Index, std::tuple<Columns...>>;
+            TCell value{};
+            if (Index < fields.size() && !fields[Index].empty() && !CSVCellParser<TCell>::parse(fields[Index], value)) {
+                value = TCell{};
+            }
+
+            auto &column = std::get<Index>(cells);
+            if constexpr (std::is_same_v<TCell, std::string>) {
+                if (column.offsets.empty()) {
+                    column.offsets.push_back(0);
+                }
+                column.text += value;
+                column.offsets.push_back(column.text.size());
+            } else {
+                column.push_back(static_cast<Stored<TCell>>(value));
+            }
+        }
+
+        template<std::size_t Index>
+        [[nodiscard]] std::uint64_t columnBytes() const {
+            using TCell = std::tuple_element_t<Index, std::tuple<Columns...>>;
+            if constexpr (std::is_same_v<TCell, std::string>) {
+                return (row_count + 1) * sizeof(std::uint64_t) + std::get<Index>(cells).text.size();
+            } else {
+                return row_count * sizeof(Stored<TCell>);
+            }
+        }
+
+        template<std::size_t Index>
+        void writeColumn(std::byte *target) const {
+            using TCell = std::tuple_element_t<Index, std::tuple<Columns...>>;
+            const auto &column = std::get<Index>(cells);
+            if constexpr (std::is_same_v<TCell, std::string>) {
+                const std::uint64_t first = 0;
+                std::memcpy(target, row_count ? column.offsets.data() : &first, (row_count + 1) * sizeof(std::uint64_t));
+                std::memcpy(target + (row_count + 1) * sizeof(std::uint64_t), column.text.data(), column.text.size());
+            } else {
+                std::memcpy(target, column.data(), column.size() * sizeof(Stored<TCell>));
+            }
+        }
+
+        struct TextColumn {
+            std::vector<std::uint64_t> offsets;
+            std::string text;
+        };
+
+        template<typename TCell>
+        using Cells = std::conditional_t<std::is_same_v<TCell, std::string>, TextColumn, std::vector<Stored<TCell>>>;
+
+        std::tuple<Cells<Columns>...> cells;
+        std::uint64_t row_count = 0;
+    };
+
+private:
+    struct Header {
+        std::uint64_t magic;        // Written last: readers never see a partly written dataset.
+        std::uint32_t version;
+        std::uint32_t columns;
+        std::uint64_t rows;
+        std::uint64_t signature;    // Column types, see signature().
+        std::uint64_t size;         // Total bytes.
+    };
+
+    static constexpr std::uint64_t magic = 0x31544553'56534350;    // "PCSVSET1"
+    static constexpr std::uint32_t version = 1;
+    static constexpr std::uint64_t column_alignment = 64;
+
+    CSVSharedDataset(const std::byte *base_, const std::size_t size_) : base(base_), size(size_) {
+    }
+
+    // One byte per column: its size, and whether it is text, floating point or signed.
+    static std::uint64_t signature() {
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (const std::uint64_t code: {columnCode<Columns>()...}) {
+            hash = (hash ^ code) * 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    template<typename TCell>
+    static constexpr std::uint64_t columnCode() {
+        if constexpr (std::is_same_v<TCell, std::string>) {
+            return 0x80;
+        } else if constexpr (CSVDecimalColumn<TCell>) {
+            return 0x100 | (TCell::precision << 16) | (TCell::scale << 24);
+        } else if constexpr (CSVBinaryKeyColumn<TCell>) {
+            return std::is_same_v<TCell, CSVUUID> ? 0x200 : 0x201;
+        } else {
+            return static_cast<std::uint8_t>(sizeof(TCell) | (std::is_floating_point_v<TCell> << 5) |
+                                             (std::is_signed_v<TCell> << 6) | (std::is_same_v<TCell, bool> << 4));
+        }
+    }
+
+    static bool isSharedMemoryName(const std::string &name) {
+        return name.size() > 1 && name[0] == '/' && name.find('/', 1) == std::string::npos;
+    }
+
+    static int openObject(const std::string &name, const int flags, const mode_t mode) {
+        return isSharedMemoryName(name) ? shm_open(name.c_str(), flags, mode) : open(name.c_str(), flags, mode);
+    }
+
+    [[nodiscard]] const Header &header() const {
+        return *reinterpret_cast<const Header *>(base);
+    }
+
+    [[nodiscard]] std::uint64_t columnOffset(const std::size_t column) const {
+        return reinterpret_cast<const std::uint64_t *>(base + sizeof(Header))[column];
+    }
+
+    template<std::size_t... Index>
+    [[nodiscard]] bool columnsInBounds(std::index_sequence<Index...>) const {
+        return (columnInBounds<Index>() && ...);
+    }
+
+    // Column 'Index' lies after the offsets and inside the mapping. A string column has 'rows + 1' non-decreasing
+    // offsets, starting at 0, and its text ends inside the mapping.
+    template<std::size_t Index>
+    [[nodiscard]] bool columnInBounds() const {
+        using TCell = std::tuple_element_t<Index, std::tuple<Columns...>>;
+        using TUnit = std::conditional_t<std::is_same_v<TCell, std::string>, std::uint64_t, Stored<TCell>>;
+        const std::uint64_t offset = columnOffset(Index);
+        if (offset < sizeof(Header) + sizeof(std::uint64_t) * sizeof...(Columns) || offset > size ||
+            offset % alignof(TUnit) != 0) {
+            return false;
+        }
+        const std::uint64_t available = size - offset;
+        const std::uint64_t rows_stored = header().rows;
+        if constexpr (std::is_same_v<TCell, std::string>) {
+            if (rows_stored >= available / sizeof(std::uint64_t)) {
+                return false;
+            }
+            const auto *offsets = reinterpret_cast<const std::uint64_t *>(base + offset);
+            const std::uint64_t text_bytes = available - (rows_stored + 1) * sizeof(std::uint64_t);
+            if (offsets[0] != 0) {
+                return false;
+            }
+            for (std::uint64_t row = 0; row < rows_stored; ++row) {
+                if (offsets[row + 1] < offsets[row]) {
+                    return false;
+                }
+            }
+            return offsets[rows_stored] <= text_bytes;
+        } else {
+            return rows_stored <= available / sizeof(TUnit);
+        }
+    }
+
+    template<typename TObject, std::size_t... Index>
+    TObject objectAt(const std::size_t row, std::index_sequence<Index...>) const {
+        return std::make_from_tuple<TObject>(std::tuple<Columns...>{Columns(get<Index>(row))...});
+    }
+
+    void unmap() {
+        if (base) {
+            munmap(const_cast<std::byte *>(base), size);
+            base = nullptr;
+        }
+    }
+
+    const std::byte *base = nullptr;
+    std::size_t size = 0;
+};
+
+template<typename... Columns>
+void CSVSharedDataset<Columns...>::Builder::publish(const std::string &name) const {
+    // Column offsets, each aligned for vector loads.
+    std::array<std::uint64_t, sizeof...(Columns)> offsets{};
+    std::uint64_t total = sizeof(Header) + sizeof(offsets);
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+        ((total = (total + column_alignment - 1) / column_alignment * column_alignment,
+          offsets[Index] = total,
+          total += columnBytes<Index>()), ...);
+    }(std::index_sequence_for<Columns...>{});
+
+    // A file is written next to its final path and renamed into place. A shared memory object cannot be renamed:
+    // it is unlinked and created again, so attached readers keep the old one.
+    const bool shared_memory = isSharedMemoryName(name);
+    const std::string target = shared_memory ? name : name + ".tmp";
+    if (shared_memory) {
+        shm_unlink(name.c_str());
+    }
+    const int descriptor = openObject(target, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (descriptor < 0 || ftruncate(descriptor, static_cast<off_t>(total)) != 0) {
+        if (descriptor >= 0) {
+            close(descriptor);
+        }
+        throw InvalidDataset(name, "cannot be created");
+    }
+    void *mapping = mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED) {
+        throw InvalidDataset(name, "cannot be mapped");
+    }
+
+    auto *base = static_cast<std::byte *>(mapping);
+    auto *header = reinterpret_cast<Header *>(base);
+    *header = {0, version, sizeof...(Columns), row_count, signature(), total};
+    std::memcpy(base + sizeof(Header), offsets.data(), sizeof(offsets));
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+        (writeColumn<Index>(base + offsets[Index]), ...);
+    }(std::index_sequence_for<Columns...>{});
+    std::atomic_ref(header->magic).store(magic, std::memory_order_release);
+
+    const bool flushed = shared_memory || msync(mapping, total, MS_SYNC) == 0;
+    munmap(mapping, total);
+    if (!flushed || (!shared_memory && std::rename(target.c_str(), name.c_str()) != 0)) {
+        throw InvalidDataset(name, "cannot be written");
+    }
+}
+
+
+
+/* ======= On-disk key index ======= */
+
+// Keys a CSVFileIndex can hash: integers and strings.
+template<typename K>
+concept CSVIndexKey = std::is_integral_v<K> || std::is_convertible_v<const K &, std::string_view>;
+
+// Read-only view of a key index written by CSVParser::buildIndex(): an open-addressing table mapping the hash of each
+// getId() to the offset of its row, mapped with mmap() and used in place. Also keeps the CSV file open to read rows.
+//
+// Layout: Header, the slots (linear probing, at most half full), then the header cells of the CSV separated by '\n'.
+class CSVFileIndex {
+public:
+    struct Slot {
+        std::uint64_t hash;
+        std::uint64_t offset;   // Row offset + 1; 0 for an empty slot.
+    };
+
+    CSVFileIndex(const CSVFileIndex &) = delete;
+    CSVFileIndex &operator=(const CSVFileIndex &) = delete;
+
+    CSVFileIndex(CSVFileIndex &&other) noexcept
+        : base(std::exchange(other.base, nullptr)), size(std::exchange(other.size, 0)), csv(std::exchange(other.csv, -1)),
+          dialect(other.dialect) {
+    }
+
+    CSVFileIndex &operator=(CSVFileIndex &&other) noexcept {
+        if (this != &other) {
+            release();
+            base = std::exchange(other.base, nullptr);
+            size = std::exchange(other.size, 0);
+            csv = std::exchange(other.csv, -1);
+            dialect = other.dialect;
+        }
+        return *this;
+    }
+
+    ~CSVFileIndex() {
+        release();
+    }
+
+    // Maps the index of 'filename' (default path: filename + ".index"). Throws InvalidIndex if it is missing,
+    // incomplete, or if the CSV file changed since the index was built.
+    static CSVFileIndex open(const std::string &filename, const std::string &index_path = "") {
+        const std::string path = index_path.empty() ? defaultPath(filename) : index_path;
+        CSVFileIndex index;
+
+        const int descriptor = ::open(path.c_str(), O_RDONLY);
+        struct stat status{};
+        if (descriptor < 0 || fstat(descriptor, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(Header)) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+            throw InvalidIndex(path, "cannot be opened");
+        }
+        index.size = static_cast<std::size_t>(status.st_size);
+        void *mapping = mmap(nullptr, index.size, PROT_READ, MAP_SHARED, descriptor, 0);
+        close(descriptor);
+        if (mapping == MAP_FAILED) {
+            throw InvalidIndex(path, "cannot be mapped");
+        }
+        index.base = static_cast<const std::byte *>(mapping);
+
+        const Header &header = index.header();
+        if (header.magic != magic || header.version != version || header.size != index.size) {
+            throw InvalidIndex(path, "is not a complete key index");
+        }
+        // probe() masks with slot_count - 1 and columns() reads from columns_offset to the end of the file.
+        const std::uint64_t max_slots = (index.size - sizeof(Header)) / sizeof(Slot);
+        if (header.slot_count == 0 || (header.slot_count & (header.slot_count - 1)) != 0 || header.slot_count > max_slots ||
+            sizeof(Header) + header.slot_count * sizeof(Slot) != header.columns_offset || header.entries >= header.slot_count) {
+            throw InvalidIndex(path, "has an invalid slot table");
+        }
+        if (header.delimiter_length == 0 || header.delimiter_length > CSVTokenizer::max_delimiter_length) {
+            throw InvalidIndex(path, "has an invalid delimiter length");
+        }
+        index.dialect = CSVTokenizer::withDelimiter(std::string_view(header.delimiter, header.delimiter_length), header.quote, header.escape);
+        if (const char *reason = index.dialect.invalidReason()) {
+            throw InvalidIndex(path, std::format("has an invalid dialect: {}", reason));
+        }
+
+        index.csv = ::open(filename.c_str(), O_RDONLY);
+        if (index.csv < 0 || fstat(index.csv, &status) != 0) {
+            throw InvalidIndex(path, std::format("cannot open '{}'", filename));
+        }
+        if (static_cast<std::uint64_t>(status.st_size) != header.csv_size || modificationTime(status) != header.csv_mtime) {
+            throw InvalidIndex(path, std::format("'{}' changed since the index was built", filename));
+        }
+        return index;
+    }
+
+    [[nodiscard]] std::size_t entries() const {
+        return static_cast<std::size_t>(header().entries);
+    }
+
+    [[nodiscard]] char delimiter() const {
+        return dialect.delimiter;
+    }
+
+    [[nodiscard]] char quote() const {
+        return dialect.quote;
+    }
+
+    [[nodiscard]] const CSVTokenizer &tokenizer() const {
+        return dialect;
+    }
+
+    [[nodiscard]] int headerRow() const {
+        return header().header_row;
+    }
+
+    // Header cells of the indexed file.
+    [[nodiscard]] std::vector<std::string> columns() const {
+        std::vector<std::string> cells;
+        const auto *text = reinterpret_cast<const char *>(base + header().columns_offset);
+        std::string_view rest(text, size - header().columns_offset);
+        while (!rest.empty()) {
+            const std::size_t newline = rest.find('\n');
+            cells.emplace_back(rest.substr(0, newline));
+            rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+        }
+        return cells;
+    }
+
+    // Calls 'visit(offset)' for the row offset of every slot holding 'hash', in insertion order. Visits each slot at
+    // most once, even in a table with no empty slot.
+    template<typename Visit>
+    void probe(const std::uint64_t hash, Visit &&visit) const {
+        const Slot *slots = reinterpret_cast<const Slot *>(base + sizeof(Header));
+        const std::uint64_t mask = header().slot_count - 1;
+        std::uint64_t slot = hash & mask;
+        for (std::uint64_t visited = 0; visited <= mask && slots[slot].offset; ++visited, slot = (slot + 1) & mask) {
+            if (slots[slot].hash == hash) {
+                visit(slots[slot].offset - 1);
+            }
+        }
+    }
+
+    // Reads the line starting at 'offset' of the CSV file, without its line ending.
+    [[nodiscard]] std::string readLine(std::uint64_t offset) const {
+        std::string line;
+        while (true) {
+            const std::size_t used = line.size();
+            line.resize(used + line_probe);
+            const ssize_t received = pread(csv, line.data() + used, line_probe, static_cast<off_t>(offset));
+            const std::size_t count = received > 0 ? static_cast<std::size_t>(received) : 0;
+            const char *newline = CSVKernels::findStructural(line.data() + used, line.data() + used + count, '\n', '\n');
+            if (newline != line.data() + used + count || count < line_probe) {
+                line.resize(static_cast<std::size_t>(newline - line.data()));
+                break;
+            }
+            line.resize(used + count);
+            offset += count;
+        }
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        return line;
+    }
+
+    // Hash stored for a key. Integers are mixed (splitmix64), strings hashed with XXH64: both are stable across processes.
+    template<CSVIndexKey K>
+    static std::uint64_t hashKey(const K &key) {
+        if constexpr (std::is_integral_v<K>) {
+            std::uint64_t value = static_cast<std::uint64_t>(key) + 0x9e3779b97f4a7c15ull;
+            value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+            value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+            return value ^ (value >> 31);
+        } else {
+            const std::string_view text(key);
+            CSVXXH64 hash;
+            hash.update(text.data(), text.data() + text.size());
+            return hash.digest();
+        }
+    }
+
+    // Writes an index for the (hash, row offset) entries of 'filename', in file order, to a temporary file renamed into place.
+    static void write(const std::string &filename, const std::string &index_path, const std::vector<Slot> &entries,
+                      const CSVTokenizer &dialect, int header_row, const std::vector<std::string> &header_cells);
+
+    static std::string defaultPath(const std::string &filename) {
+        return filename + ".index";
+    }
+
+private:
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::int32_t header_row;
+        std::uint64_t slot_count;       // Power of two.
+        std::uint64_t entries;
+        std::uint64_t csv_size;         // Size and modification time of the indexed file, checked by open().
+        std::uint64_t csv_mtime;
+        std::uint64_t columns_offset;
+        std::uint64_t size;
+        // Dialect, stored field by field (not as a CSVTokenizer) so the file format does not follow its layout.
+        char delimiter[CSVTokenizer::max_delimiter_length];
+        std::uint8_t delimiter_length;
+        char quote;
+        char escape;
+        char reserved[5];
+    };
+    static_assert(sizeof(Header) == 80, "CSVFileIndex::Header is part of the file format");
+
+    static constexpr std::uint64_t magic = 0x31584449'56534350;    // "PCSVIDX1"
+    static constexpr std::uint32_t version = 3;
+    static constexpr std::size_t line_probe = 4096;
+
+    CSVFileIndex() = default;
+
+    static std::uint64_t modificationTime(const struct stat &status) {
+#ifdef __APPLE__
+        return static_cast<std::uint64_t>(status.st_mtimespec.tv_sec) * 1000000000ull + status.st_mtimespec.tv_nsec;
+#else
+        return static_cast<std::uint64_t>(status.st_mtim.tv_sec) * 1000000000ull + status.st_mtim.tv_nsec;
+#endif
+    }
+
+    [[nodiscard]] const Header &header() const {
+        return *reinterpret_cast<const Header *>(base);
+    }
+
+    void release() {
+        if (base) {
+            munmap(const_cast<std::byte *>(base), size);
+            base = nullptr;
+        }
+        if (csv >= 0) {
+            close(csv);
+            csv = -1;
+        }
+    }
+
+    const std::byte *base = nullptr;
+    std::size_t size = 0;
+    int csv = -1;
+    CSVTokenizer dialect{',', '"'};
+};
+
+inline void CSVFileIndex::write(const std::string &filename, const std::string &index_path, const std::vector<Slot> &entries,
+                                const CSVTokenizer &dialect, const int header_row,
+                                const std::vector<std::string> &header_cells) {
+    std::uint64_t slot_count = 16;
+    while (slot_count < entries.size() * 2) {
+        slot_count <<= 1;
+    }
+    std::vector<Slot> slots(slot_count, Slot{0, 0});
+    for (const Slot &entry: entries) {
+        std::uint64_t slot = entry.hash & (slot_count - 1);
+        while (slots[slot].offset) {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        slots[slot] = {entry.hash, entry.offset + 1};
+    }
+
+    std::string columns;
+    for (std::size_t cell = 0; cell < header_cells.size(); ++cell) {
+        columns += (cell ? "\n" : "") + header_cells[cell];
+    }
+
+    struct stat status{};
+    if (stat(filename.c_str(), &status) != 0) {
+        throw InvalidIndex(index_path, std::format("cannot stat '{}'", filename));
+    }
+    Header header{};
+    header.magic = magic;
+    header.version = version;
+    header.header_row = header_row;
+    header.slot_count = slot_count;
+    header.entries = entries.size();
+    header.csv_size = static_cast<std::uint64_t>(status.st_size);
+    header.csv_mtime = modificationTime(status);
+    header.columns_offset = sizeof(Header) + slot_count * sizeof(Slot);
+    header.size = header.columns_offset + columns.size();
+    const std::string delimiter_text = dialect.delimiterText();
+    std::memcpy(header.delimiter, delimiter_text.data(), delimiter_text.size());
+    header.delimiter_length = static_cast<std::uint8_t>(delimiter_text.size());
+    header.quote = dialect.quote;
+    header.escape = dialect.escape;
+
+    const std::string temporary = index_path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(slots.data()), static_cast<std::streamsize>(slots.size() * sizeof(Slot)));
+        file.write(columns.data(), static_cast<std::streamsize>(columns.size()));
+        if (!file.flush()) {
+            throw InvalidIndex(index_path, "cannot be written");
+        }
+    }
+    if (std::rename(temporary.c_str(), index_path.c_str()) != 0) {
+        throw InvalidIndex(index_path, "cannot be written");
+    }
+}
+
+#endif
+
+
+/* ======= Arrow C data interface ======= */
+
+// ABI-stable structures of the Arrow C data interface (arrow.apache.org/docs/format/CDataInterface.html), declared
+// here unless an Arrow header already did. No Arrow library is needed to produce or consume them.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    const char *format;
+    const char *name;
+    const char *metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema **children;
+    struct ArrowSchema *dictionary;
+    void (*release)(struct ArrowSchema *);
+    void *private_data;
+};
+
+struct ArrowArray {
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void **buffers;
+    struct ArrowArray **children;
+    struct ArrowArray *dictionary;
+    void (*release)(struct ArrowArray *);
+    void *private_data;
+};
+
+#endif
+
+// Column types an Arrow export can hold: integers, floating point, bool, decimals, UUIDs and IP addresses (fixed-size
+// binary), blobs (binary) and text.
+template<typename T>
+concept CSVArrowColumn = (std::is_arithmetic_v<T> && !std::is_same_v<T, long double>) || CSVDecimalColumn<T> ||
+                         CSVBinaryKeyColumn<T> || CSVBlobColumn<T> || std::is_same_v<T, std::string> ||
+                         std::is_same_v<T, std::string_view>;
+
+// Growable buffer aligned and padded to 64 bytes, as recommended by the Arrow format. New bytes are zeroed.
+class CSVArrowBuffer {
+public:
+    static constexpr std::size_t alignment = 64;
+
+    CSVArrowBuffer() = default;
+
+    CSVArrowBuffer(CSVArrowBuffer &&other) noexcept
+        : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)),
+          capacity(std::exchange(other.capacity, 0)) {
+    }
+
+    CSVArrowBuffer &operator=(CSVArrowBuffer &&other) noexcept {
+        if (this != &other) {
+            free();
+            bytes = std::exchange(other.bytes, nullptr);
+            length = std::exchange(other.length, 0);
+            capacity = std::exchange(other.capacity, 0);
+        }
+        return *this;
+    }
+
+    ~CSVArrowBuffer() {
+        free();
+    }
+
+    void append(const void *source, const std::size_t count) {
+        resize(length + count);
+        std::memcpy(bytes + length - count, source, count);
+    }
+
+    // Sets bit 'index' of a bitmap, growing it as needed.
+    void setBit(const std::size_t index, const bool value) {
+        if (index / 8 >= length) {
+            resize(index / 8 + 1);
+        }
+        bytes[index / 8] |= static_cast<std::byte>(value << (index % 8));
+    }
+
+    void resize(const std::size_t size) {
+        if (size > capacity) {
+            const std::size_t grown = (std::max(size, capacity * 2) + alignment - 1) / alignment * alignment;
+            auto *larger = static_cast<std::byte *>(::operator new(grown, std::align_val_t{alignment}));
+            if (bytes) {
+                std::memcpy(larger, bytes, length);
+            }
+            std::memset(larger + length, 0, grown - length);
+            free();
+            bytes = larger;
+            capacity = grown;
+        }
+        length = size;
+    }
+
+    [[nodiscard]] std::byte *data() const {
+        return bytes;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return length;
+    }
+
+private:
+    void free() {
+        if (bytes) {
+            ::operator delete(bytes, std::align_val_t{alignment});
+            bytes = nullptr;
+        }
+    }
+
+    std::byte *bytes = nullptr;
+    std::size_t length = 0, capacity = 0;
+};
+
+// Fills ArrowArray / ArrowSchema structures that own their buffers, names and children through 'private_data'.
+// Their release callbacks free everything, children first, as the interface requires.
+struct CSVArrowExport {
+    static void array(ArrowArray *out, const std::int64_t length, const std::int64_t null_count,
+                      std::vector<CSVArrowBuffer> buffers, std::vector<ArrowArray *> children = {}) {
+        auto *owned = new ArrayData{std::move(buffers), {}, std::move(children)};
+        for (const CSVArrowBuffer &buffer: owned->buffers) {
+            owned->pointers.push_back(buffer.data());
+        }
+        *out = {length, null_count, 0, static_cast<std::int64_t>(owned->pointers.size()),
+                static_cast<std::int64_t>(owned->children.size()), owned->pointers.data(),
+                owned->children.empty() ? nullptr : owned->children.data(), nullptr, releaseArray, owned};
+    }
+
+    static void schema(ArrowSchema *out, std::string format, std::string name, const std::int64_t flags,
+                       std::vector<ArrowSchema *> children = {}) {
+        auto *owned = new SchemaData{std::move(format), std::move(name), std::move(children)};
+        *out = {owned->format.c_str(), owned->name.c_str(), nullptr, flags, static_cast<std::int64_t>(owned->children.size()),
+                owned->children.empty() ? nullptr : owned->children.data(), nullptr, releaseSchema, owned};
+    }
+
+private:
+    struct ArrayData {
+        std::vector<CSVArrowBuffer> buffers;
+        std::vector<const void *> pointers;
+        std::vector<ArrowArray *> children;
+    };
+
+    struct SchemaData {
+        std::string format, name;
+        std::vector<ArrowSchema *> children;
+    };
+
+    static void releaseArray(ArrowArray *array) {
+        auto *owned = static_cast<ArrayData *>(array->private_data);
+        for (ArrowArray *child: owned->children) {
+            if (child->release) {
+                child->release(child);
+            }
+            delete child;
+        }
+        delete owned;
+        array->release = nullptr;
+    }
+
+    static void releaseSchema(ArrowSchema *schema) {
+        auto *owned = static_cast<SchemaData *>(schema->private_data);
+        for (ArrowSchema *child: owned->children) {
+            if (child->release) {
+                child->release(child);
+            }
+            delete child;
+        }
+        delete owned;
+        schema->release = nullptr;
+    }
+};
+
+// Builds one Arrow column: a validity bitmap, then the values (bit-packed for bool, 128-bit for decimals), or offsets
+// and UTF-8 data for text (decoded bytes for blobs).
+// Empty and unconvertible cells are nulls, except for text columns where an empty cell is an empty string.
+template<typename TCell>
+class CSVArrowColumnBuilder {
+    static constexpr bool is_text = std::is_same_v<TCell, std::string> || std::is_same_v<TCell, std::string_view>;
+    static constexpr bool has_offsets = is_text || CSVBlobColumn<TCell>;
+
+public:
+    void append(const std::string_view cell, const bool present) {
+        bool valid = present;
+        if constexpr (is_text) {
+            if (valid) {
+                data.append(cell.data(), cell.size());
+            }
+            offsets.push_back(static_cast<std::int64_t>(data.size()));
+        } else if constexpr (CSVBlobColumn<TCell>) {
+            // Decoded in place at the end of the data buffer.
+            const std::size_t used = data.size(), size = TCell::decodedSize(cell);
+            valid = valid && !cell.empty() && size != TCell::invalid_size;
+            if (valid) {
+                data.resize(used + size);
+                valid = TCell::decode(cell, reinterpret_cast<std::uint8_t *>(data.data() + used));
+                if (!valid) {
+                    data.resize(used);
+                }
+            }
+            offsets.push_back(static_cast<std::int64_t>(data.size()));
+        } else {
+            TCell value{};
+            valid = valid && !cell.empty() && CSVCellParser<TCell>::parse(cell, value);
+            if constexpr (std::is_same_v<TCell, bool>) {
+                values.setBit(length, valid && value);
+                values.resize((length + 8) / 8);
+            } else if constexpr (CSVDecimalColumn<TCell>) {
+                // decimal128: two little-endian 64-bit words, sign-extended.
+                const auto raw = valid ? value.raw() : 0;
+                const std::uint64_t words[2] = {static_cast<std::uint64_t>(raw), static_cast<std::uint64_t>(raw >> 63 >> 1)};
+                values.append(words, sizeof(words));
+            } else {
+                value = valid ? value : TCell{};
+                values.append(&value, sizeof(TCell));
+            }
+        }
+        validity.setBit(length, valid);
+        validity.resize((length + 8) / 8);
+        null_count += !valid;
+        ++length;
+    }
+
+    // Moves the buffers into 'array' and describes them in 'schema'. Text and blobs use 32-bit offsets ("u", "z") when they fit.
+    void exportTo(ArrowArray *array, ArrowSchema *schema, const std::string &name) {
+        std::vector<CSVArrowBuffer> buffers;
+        buffers.push_back(std::move(validity));
+        std::string format = formatOf();
+
+        if constexpr (has_offsets) {
+            CSVArrowBuffer offset_buffer;
+            if (data.size() <= static_cast<std::size_t>(std::numeric_limits<std::int32_t>::max())) {
+                offset_buffer.resize(4 * (length + 1));
+                auto *narrow = reinterpret_cast<std::int32_t *>(offset_buffer.data());
+                narrow[0] = 0;
+                for (std::size_t row = 0; row < length; ++row) {
+                    narrow[row + 1] = static_cast<std::int32_t>(offsets[row]);
+                }
+            } else {
+                format = is_text ? "U" : "Z";
+                offset_buffer.append(&zero_offset, sizeof(zero_offset));
+                offset_buffer.append(offsets.data(), offsets.size() * sizeof(std::int64_t));
+            }
+            buffers.push_back(std::move(offset_buffer));
+            buffers.push_back(std::move(data));
+        } else {
+            buffers.push_back(std::move(values));
+        }
+
+        CSVArrowExport::array(array, static_cast<std::int64_t>(length), static_cast<std::int64_t>(null_count), std::move(buffers));
+        CSVArrowExport::schema(schema, std::move(format), name, ARROW_FLAG_NULLABLE);
+    }
+
+private:
+    static std::string formatOf() {
+        if constexpr (is_text) {
+            return "u";
+        } else if constexpr (CSVBlobColumn<TCell>) {
+            return "z";
+        } else if constexpr (std::is_same_v<TCell, bool>) {
+            return "b";
+        } else if constexpr (CSVDecimalColumn<TCell>) {
+            return std::format("d:{},{}", TCell::precision, TCell::scale);
+        } else if constexpr (CSVBinaryKeyColumn<TCell>) {
+            return "w:16";
+        } else if constexpr (std::is_floating_point_v<TCell>) {
+            return sizeof(TCell) == 4 ? "f" : "g";
+        } else {
+            constexpr const char *codes = std::is_signed_v<TCell> ? "csil" : "CSIL";
+            return {codes[sizeof(TCell) == 1 ? 0 : sizeof(TCell) == 2 ? 1 : sizeof(TCell) == 4 ? 2 : 3]};
+        }
+    }
+
+    static constexpr std::int64_t zero_offset = 0;
+
+    CSVArrowBuffer validity, values, data;
+    std::vector<std::int64_t> offsets;  // End offset of each text cell.
+    std::size_t length = 0, null_count = 0;
+};
+
+
+/* ======= CSVParser class definition ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+class CSVParser {
+private:
+    using front_t = typename front_type<Types...>::type;
+
+    static constexpr std::size_t max_args_unique_type = getMaxConstructibleArityUniqueType<TObject, front_t, 40>();
+    static constexpr std::size_t max_args_multiple_types = getMaxConstructibleArityMultipleTypes<TObject, sizeof...(Types), Types...>();
+
+    static inline std::vector<char> default_delimiters = {',', '\t', ';', '|', ':', ' ', '~'};
+    static inline std::vector<char> default_quotes = {'"', '\''};
+
+    std::vector<std::string> header;
+    bool custom_header = false, has_id = false, validate_utf8 = false;
+    unsigned thread_count = 1;
+    bool ordered = true, verbose = true;
+    std::size_t checkpoint_every = 0;
+    CSVChecksum checksum_type = CSVChecksum::None;
+    std::optional<std::uint64_t> expected_checksum;
+    std::function<void(const CSVCheckpoint &)> checkpoint_callback;
+    std::uint64_t chunk_size_preference = 0;
+    CSVStats stats;
+    bool incremental = false;
+    CSVStringArena *arena_target = nullptr;     // Arena of the running parseObjectsWithArena() call.
+    bool perf_counters = false;
+    CSVTrace *trace = nullptr;
+    static inline int objectIdCounter = 0;
+    char delimiter, quote;
+    std::string delimiter_tail;     // Rest of a multi-byte delimiter (see setDelimiter(std::string_view)).
+    char escape = '\0';
+    int header_row;
+
+    [[nodiscard]] bool checkMaxArgs(const std::size_t value) const {
+        switch (sizeof...(Types)) {
+            case 1:
+                return (max_args_unique_type == value || std::is_same_v<TObject, std::vector<front_t>>);
+            default:
+                return max_args_multiple_types == value;
+        }
+    }
+
+    [[nodiscard]] bool checkMaxArgs(const std::vector<std::string>& temp) const {
+        switch (sizeof...(Types)) {
+            case 1:
+                if (max_args_unique_type != temp.size() && !std::is_same_v<TObject, std::vector<front_t> >) {
+                    throw WrongHeaderLength(max_args_unique_type, temp);
+                }
+            break;
+            default:
+                if (max_args_multiple_types != temp.size()) {
+                    throw WrongHeaderLength(max_args_multiple_types, temp);
+                }
+        }
+        return true;
+    }
+
+    void setHeader(const std::vector<std::string>& temp) {
+        if (checkMaxArgs(temp)) {
+            header = temp;
+        }
+    }
+
+    static bool getBoolMeaning(const std::string &trimmed_boolean) {
+        std::string lower_temp = trimmed_boolean;
+        std::ranges::transform(lower_temp, lower_temp.begin(), ::tolower);
+
+        return (lower_temp[0] == 'y' || lower_temp[0] == 't' || lower_temp[0] == '1');
+    }
+
+    // Determines if the original header can be replaced with user's preferences.
+    // A function which checks and eventually predicts custom headers.
+    [[nodiscard]] std::pair<bool, char> trust_header(const std::string &filename);
+
+    // Parses a single CSV formatted row. The row buffer is reused by the tokenizer (quoted fields are unescaped in place).
+    TObject parseObjectFromRow(const CSVTokenizer &splitter, char *begin, char *end, std::vector<std::string_view> &fields) const;
+
+    // Converts the fields of one split row into an object, reading at most 'columns' fields when all columns have one
+    // type (the header's length by default).
+    TObject objectFromFields(const std::vector<std::string_view> &fields, std::size_t columns) const;
+
+    TObject objectFromFields(const std::vector<std::string_view> &fields) const {
+        return objectFromFields(fields, header.size());
+    }
+
+    // Reads every data row from the file and adds each object to 'result' through 'insert(result, object)'.
+    // Objects come in file order, unless parallel parsing runs with setOrdered(false).
+    template<typename Result, typename Inserter>
+    void parseRows(const std::string &filename, Result &result, Inserter &&insert);
+
+    void resetStats(const std::string &filename, const std::uint64_t bytes) {
+        stats = {};
+        stats.filename = filename;
+        stats.bytes = bytes;
+        stats.kernel = CSVKernels::active().name;
+    }
+
+    // Adds one object to any supported container (vector, set, unordered_map by getId(), of objects or shared_ptr).
+    template<typename Result>
+    static void insertObject(Result &result, TObject &&object);
+
+    // Moves every element of 'from' into 'into' (relaxed-order merge of per-worker containers).
+    template<typename Result>
+    static void mergeInto(Result &into, Result &&from);
+
+    // Byte range of the rows following the header, with the dialect detected for the file.
+    struct DataSection {
+        std::string filename;
+        std::uint64_t begin = 0, end = 0;
+        CSVTokenizer tokenizer{',', '"'};
+    };
+
+    // Detects the header and dialect (see initialize()) and locates the data rows.
+    DataSection openDataSection(const std::string &filename);
+
+    // Outcome of parsing one byte range of the data section.
+    struct RangeResult {
+        std::size_t lines = 0;          // Lines consumed, empty ones included.
+        std::size_t rows = 0;           // Objects emitted.
+        std::size_t invalid_line = 0;   // 1-based line (within the range) failing UTF-8 validation, 0 if none.
+        std::uint64_t checksum = 0;     // Of the range bytes, when a checksum is enabled.
+        CSVPerfStats perf;              // With setPerfCounters(true), when the counters are available.
+    };
+
+    // Parses the lines of [begin, end) of the section on the calling thread. Stops at the first invalid line.
+    // With 'checkpoint_base' (lines and rows already consumed before 'begin'), checkpoints are emitted as set by setCheckpoint().
+    // With 'checksum', every byte of the range is added to it while reading.
+    template<typename Emit>
+    RangeResult parseRange(const DataSection &section, std::uint64_t begin, std::uint64_t end, Emit &&emit,
+                           const RangeResult *checkpoint_base = nullptr, CSVChecksumState *checksum = nullptr) const;
+
+    // Adds the bytes preceding the data section (header rows) to 'checksum'.
+    static void checksumPrefix(const DataSection &section, CSVChecksumState &checksum);
+
+    // Stores the checksum in the stats and compares it with the expected one (throws ChecksumMismatch).
+    void verifyChecksum(const std::string &filename, std::uint64_t checksum);
+
+    void emitCheckpoint(const DataSection &section, std::uint64_t offset, std::size_t line, std::size_t rows) const {
+        checkpoint_callback({section.filename, offset, line, rows, section.tokenizer.delimiter, section.tokenizer.quote, header_row, header,
+                             section.tokenizer.delimiterText().substr(1), section.tokenizer.escape});
+    }
+
+    // Adaptive parallel parse of the section: chunk size from sampled row lengths, thread count from early-chunk throughput.
+    template<typename Result, typename Inserter>
+    void parseRowsParallel(const DataSection &section, Result &result, Inserter &&insert);
+
+    // Objects of one content-defined chunk, kept between parses by setIncremental().
+    struct CachedChunk {
+        std::vector<TObject> objects;
+        std::size_t lines = 0;
+    };
+
+    // A content-defined chunk of the data section: [begin, end), its line count and the XXH64 of its bytes.
+    struct ContentChunk {
+        std::uint64_t begin = 0, end = 0;
+        std::size_t lines = 0;
+        std::uint64_t hash = 0;
+    };
+
+    // Cached chunks by content hash, valid for the dialect and header they were parsed with.
+    std::unordered_map<std::uint64_t, CachedChunk> chunk_cache;
+    std::string chunk_cache_dialect;
+
+    // Cuts the section after lines whose CRC32C matches 'content_chunk_mask', so boundaries move with the content
+    // and an edit only changes the chunks around it. Adds every byte to 'checksum' when given.
+    std::vector<ContentChunk> planContentChunks(const DataSection &section, CSVChecksumState *checksum) const;
+
+    // Parses only the chunks missing from the cache (with the work-stealing pool), then inserts every chunk in file order.
+    template<typename Result, typename Inserter>
+    void parseRowsIncremental(const DataSection &section, Result &result, Inserter &&insert);
+
+    // Content-defined chunks have between min_content_chunk_lines and max_content_chunk_bytes, about 1024 lines on average.
+    static constexpr std::uint32_t content_chunk_mask = (1 << 10) - 1;
+    static constexpr std::size_t min_content_chunk_lines = 64;
+    static constexpr std::uint64_t max_content_chunk_bytes = 4 << 20;
+
+    template<typename Result>
+    void parseSmallFilesInto(const std::vector<std::string> &filenames, CSVBatchResult<Result> &batch);
+
+    // Checks the lines of [begin, end) without constructing objects. Lines of the errors are relative to 'begin'.
+    // At most 'max_errors' errors are stored in 'report', all of them are counted.
+    void lintRange(const DataSection &section, std::uint64_t begin, std::uint64_t end, std::size_t max_errors,
+                   CSVLintReport &report, std::size_t &lines) const;
+
+    // Appends one row to 'out' in the output dialect of 'options', taking the fields at 'projection'.
+    static void writeNormalizedRow(const std::vector<std::string_view> &fields, const std::vector<std::size_t> &projection,
+                                   const CSVNormalizeOptions &options, std::string &out);
+
+    // Indexes of the fields failing conversion to the type of their column.
+    template<std::size_t... Index>
+    static void findInvalidFields(const std::vector<std::string_view> &fields, std::vector<std::size_t> &invalid,
+                                  std::index_sequence<Index...>);
+
+    template<typename TCell>
+    static void checkField(const std::vector<std::string_view> &fields, std::size_t index, std::vector<std::size_t> &invalid);
+
+    // Parses one small file with a reused reader. Returns an error message, or an empty string on success.
+    template<typename Result>
+    std::string parseSmallFile(const std::string &filename, const CSVTokenizer &splitter, CSVBlockReader &reader,
+                               std::vector<std::string_view> &fields, Result &result, std::size_t &rows) const;
+
+    // Files handed to one task of parseSmallFiles(), and the reader block size used for them.
+    static constexpr std::size_t small_files_per_task = 16;
+    static constexpr std::size_t small_file_block_size = 64 << 10;
+
+    // Chunk size for the section: setChunkSize(), or about target_rows_per_chunk rows and at least 4 chunks per thread.
+    [[nodiscard]] std::uint64_t chooseChunkSize(const DataSection &section, unsigned max_threads) const;
+
+    // Parses every file of the batch with the work-stealing pool. Objects of each file are added to 'results[file]' in file order.
+    template<typename Result, typename Inserter>
+    void parseFiles(const std::vector<std::string> &filenames, std::vector<Result> &results, Inserter &&insert);
+
+    // Splits [begin, end) into ranges of about 'size' bytes, each starting at the beginning of a line.
+    static std::vector<std::uint64_t> planChunks(const std::string &filename, std::uint64_t begin, std::uint64_t end, std::uint64_t size);
+
+    // Average line length over the first bytes of [begin, end).
+    static double sampleRowLength(const std::string &filename, std::uint64_t begin, std::uint64_t end);
+
+    [[nodiscard]] unsigned maxThreads() const {
+        return thread_count ? thread_count : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Inputs smaller than this are always parsed on the calling thread.
+    static constexpr std::uint64_t parallel_min_bytes = 4 << 20;
+    static constexpr std::uint64_t target_rows_per_chunk = 1 << 14;
+    static constexpr std::uint64_t min_chunk_size = 256 << 10, max_chunk_size = 16 << 20;
+
+    // Converts the field at 'index'. Missing or unconvertible fields fall back to a value-initialized TCell.
+    template<typename TCell>
+    static TCell parseCSVCell(const std::vector<std::string_view> &fields, std::size_t index);
+
+    template<std::size_t... Index>
+    static std::tuple<Types...> buildTupleFromFields(const std::vector<std::string_view> &fields, std::index_sequence<Index...>);
+
+    // Drops the '\r' left by CRLF line endings.
+    static void trimLineEnding(std::string &row) {
+        if (!row.empty() && row.back() == '\r') {
+            row.pop_back();
+        }
+    }
+
+    // The dialect as set or detected. Throws InvalidDialect if its bytes overlap (e.g. an escape character that is
+    // also the detected delimiter).
+    [[nodiscard]] CSVTokenizer tokenizer() const {
+        const CSVTokenizer dialect = CSVTokenizer::withDelimiter(std::string(1, delimiter) + delimiter_tail, quote, escape);
+        if (const char *reason = dialect.invalidReason()) {
+            throw InvalidDialect(dialect.delimiterText(), quote, escape, reason);
+        }
+        return dialect;
+    }
+
+    void showStats(const std::string& filename) {
+        std::string log_delimiter = tokenizer().delimiterText();
+        if (delimiter == '\t') {
+            log_delimiter = "[TAB \\t]";
+        }
+        std::cout << std::format("[CSV Reader] Fetching data from {}", filename) << std::endl;
+        if (custom_header) {
+            std::cout << std::format("[CSV Reader] Set header to user's preferences.") << std::endl;
+        } else {
+            std::cout << std::format("[CSV Reader] Set header from CSV (row: {} | delimiter: '{}' | quote: '{}')", header_row,
+                                     log_delimiter, quote) << std::endl;
+        }
+        std::cout << std::format("[CSV Reader] Will retrieve data from the first {} columns, separated by '{}', quoted with '{}'",
+                                 header.size(), log_delimiter, quote) << std::endl;
+    }
+
+public:
+    // Create a CSV Parser using a predefined header.
+    explicit CSVParser(const std::vector<std::string> &header_)
+        : header({}),
+          delimiter('\0'),
+          quote('"'),
+          header_row(1){
+        try {
+            setHeader(header_);
+        } catch (WrongHeaderLength&) {
+            throw;
+        }
+    }
+
+    // Create a CSV Parser using default CSV file's header.
+    explicit CSVParser()
+        : header({}), delimiter('\0'), quote('"'),  header_row(1){
+    }
+
+    // Set the CSV file's delimiter symbol.
+    void setDelimiter(const char delimiter_symbol) {
+        delimiter = delimiter_symbol;
+        delimiter_tail.clear();
+    }
+
+    // Set a delimiter of up to 8 bytes, such as "||" or "::". Multi-byte delimiters are never detected automatically.
+    void setDelimiter(const std::string_view delimiter_text) {
+        if (delimiter_text.empty() || delimiter_text.size() > CSVTokenizer::max_delimiter_length ||
+            delimiter_text.find_first_of("\r\n") != std::string_view::npos) {
+            std::clog << std::format("[CSV Parser Error] Failed to set delimiter '{}'. Reason: It should have 1 to {} bytes and no line break.",
+                                     delimiter_text, CSVTokenizer::max_delimiter_length) << std::endl;
+            return;
+        }
+        delimiter = delimiter_text.front();
+        delimiter_tail = delimiter_text.substr(1);
+    }
+
+    // Set the CSV file's quotation symbol.
+    void setQuote(const char quotation_symbol) {
+        quote = quotation_symbol;
+    }
+
+    // Set an escape character (e.g. '\\'): the byte after it is read literally, inside or outside quotes, so "a\,b" is
+    // one field. '\0' (default) disables it. The whole dialect is checked once the delimiter is known, when parsing
+    // starts: an escape character that is the quote or part of the delimiter throws InvalidDialect.
+    void setEscape(const char escape_symbol) {
+        escape = escape_symbol;
+    }
+
+    // Set the CSV file's header row. Index should start from 1 (Not critical validation).
+    void setHeaderRow(const int row) {
+        if (row < 1) {
+            std::clog << std::format("[CSV Parser Error] Failed to set header row to [{}]. Reason: Index should start from 1.", row) << std::endl;
+            return;
+        }
+        header_row = row;
+    }
+
+    // Print the detected header and dialect to std::cout on every parse (Default: true).
+    void setVerbose(const bool enabled) {
+        verbose = enabled;
+    }
+
+    // Reject rows that are not well-formed UTF-8 (throws InvalidEncoding). Disabled by default.
+    void setValidateUTF8(const bool enabled) {
+        validate_utf8 = enabled;
+    }
+
+    // Number of threads used to parse a file. 1 (default) parses on the calling thread, 0 picks it automatically.
+    // Objects are still inserted in file order. Inputs smaller than 4 MB are always parsed on the calling thread.
+    void setThreads(const unsigned threads) {
+        thread_count = threads;
+    }
+
+    // Relaxed order (false): parallel workers fill their own containers, merged at the end, instead of buffering
+    // every chunk for an ordered merge. Objects of a vector are no longer in file order, and for duplicate keys
+    // it is unspecified which row is kept. Default: true.
+    void setOrdered(const bool keep_order) {
+        ordered = keep_order;
+    }
+
+    // Bytes per parallel chunk. 0 (default) derives it from the sampled row length.
+    void setChunkSize(const std::uint64_t bytes) {
+        chunk_size_preference = bytes;
+    }
+
+    // Calls 'callback' every 'rows' objects with a checkpoint at the next record boundary (0 disables it).
+    // Checkpoints need a single reading position, so files are then parsed on the calling thread.
+    void setCheckpoint(const std::size_t rows, std::function<void(const CSVCheckpoint &)> callback) {
+        checkpoint_every = callback ? rows : 0;
+        checkpoint_callback = std::move(callback);
+    }
+
+    // Computes a checksum of the raw file bytes in the same pass as the parse, reported by getStats().
+    // CRC32C uses the SSE4.2 instruction when available and is combined across parallel chunks; XXH64 keeps the
+    // parse on the calling thread. With 'expected' set, a different checksum throws ChecksumMismatch.
+    // Applies to parseObjectsFromFile() and parsePointerObjectsFromFile().
+    void setChecksum(const CSVChecksum algorithm, const std::optional<std::uint64_t> expected = std::nullopt) {
+        checksum_type = algorithm;
+        expected_checksum = expected;
+    }
+
+    // Keeps the objects of the last parsed file per content-defined chunk. The next parse hashes the file, re-tokenizes
+    // only the chunks whose hash is new and copies the objects of the others, so a large file rewritten with small
+    // edits is not parsed again in full. Costs one copy of the objects in memory. Disabling it drops the cache.
+    // Applies to parseObjectsFromFile() and parsePointerObjectsFromFile() when no checkpoint is set.
+    void setIncremental(const bool enabled) requires std::is_copy_constructible_v<TObject> {
+        incremental = enabled;
+        if (!enabled) {
+            chunk_cache.clear();
+        }
+    }
+
+    // Reads the hardware counters (cycles, instructions, LLC misses, branch misses) of the row loop into
+    // getStats().perf, with the cost of the tokenize, convert and insert stages sampled on one row in 64.
+    // Applies to the functions parsing rows into objects. Where Linux perf counters cannot be opened (other systems,
+    // perf_event_paranoid, some containers and VMs), the parse runs unchanged and perf.available stays false.
+    void setPerfCounters(const bool enabled) {
+        perf_counters = enabled;
+    }
+
+    // Records spans of the parse phases into 'trace' (nullptr to stop): header sniffing, chunk planning, block reads,
+    // the parse of each chunk, insertion and merging, per thread. The trace must outlive the parses it records.
+    void setTrace(CSVTrace *trace_) {
+        trace = trace_;
+    }
+
+    // Statistics of the last parse.
+    [[nodiscard]] const CSVStats &getStats() const {
+        return stats;
+    }
+
+    // The instruction set used by the tokenizer, UTF-8 validation and numeric kernels.
+    static CSVKernelLevel activeKernel() {
+        return CSVKernels::active().level;
+    }
+
+    static const char *activeKernelName() {
+        return CSVKernels::active().name;
+    }
+
+    // Forces a kernel level for all parsers (testing and benchmarking). Returns the level actually selected.
+    static CSVKernelLevel forceKernel(const CSVKernelLevel level) {
+        return CSVKernels::force(level);
+    }
+
+    void initialize(std::string& row, std::ifstream& file, const std::string& filename) {
+        const std::pair<int, char> parseType(this->trust_header(filename));
+
+        custom_header = parseType.first;
+        delimiter = parseType.second;
+
+        if (!file.is_open()) {
+            throw FileOpenException(filename);
+        }
+
+        if (verbose) {
+            showStats(filename);
+        }
+        int row_counter(1);
+        do {
+            std::getline(file, row);
+            row_counter++;
+        } while (row_counter == header_row);
+    }
+
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+    Container<K, TObject> parseObjectsFromFile(const std::string &filename);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    Container<TObject> parseObjectsFromFile(const std::string &filename);
+
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, std::shared_ptr<TObject>>>::value)
+    Container<K, std::shared_ptr<TObject>> parsePointerObjectsFromFile(const std::string &filename);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    Container<std::shared_ptr<TObject>> parsePointerObjectsFromFile(const std::string &filename);
+
+    // Parses with std::string_view columns: the text of every such cell is stored in one chunked arena returned with
+    // the objects, instead of one allocation per string. Objects must not outlive the returned CSVArenaResult.
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+    CSVArenaResult<Container<K, TObject>> parseObjectsWithArena(const std::string &filename);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    CSVArenaResult<Container<TObject>> parseObjectsWithArena(const std::string &filename);
+
+    // Parses a batch of files with a work-stealing scheduler: large files are split into chunks, small files are single tasks,
+    // and idle workers steal from busy ones. Uses setThreads() workers (0: all cores). Returns one container per file, in order.
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+    std::vector<Container<K, TObject>> parseObjectsFromFiles(const std::vector<std::string> &filenames);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    std::vector<Container<TObject>> parseObjectsFromFiles(const std::vector<std::string> &filenames);
+
+    // Streams every object to 'sink(TObject&&)' on the calling thread, in file order, emitting checkpoints if set.
+    template<typename Sink>
+        requires std::invocable<Sink &, TObject &&>
+    void parseObjectsIntoSink(const std::string &filename, Sink &&sink);
+
+    // Continues a parse from a checkpoint, restoring its dialect and header. 'target' is either a container
+    // (vector, set, unordered_map) the remaining objects are appended to, or a sink called with each object.
+    // Throws InvalidCheckpoint if the offset is not a record boundary of the file.
+    template<typename Target>
+    void resumeFromCheckpoint(const CSVCheckpoint &checkpoint, Target &target);
+
+#ifdef CSV_PARSER_POSIX
+    // Parses the file into a CSVSharedDataset<Types...> published under 'name' ('/name': POSIX shared memory,
+    // otherwise a file path). Other processes attach it with CSVSharedDataset<Types...>::attach(name) and read
+    // rows through views instead of parsing the file again. Needs one type per column.
+    void publishDataset(const std::string &filename, const std::string &name)
+        requires(CSVSharedColumn<Types> && ...);
+
+    // Writes an on-disk key index of the file (default path: filename + ".index"): the hash of every getId() and the
+    // offset of its row. Lookups through findById() then parse only the requested row. The index is tied to the
+    // file's size and modification time: rebuild it when the file changes.
+    template<typename K>
+        requires(HasIdMember<TObject, K> && CSVIndexKey<K>)
+    void buildIndex(const std::string &filename, const std::string &index_path = "");
+
+    // Parses the row holding 'key' (the last one, as for unordered_map containers), or returns nullopt.
+    // Uses the dialect and header stored in the index.
+    template<typename K>
+        requires(HasIdMember<TObject, K> && CSVIndexKey<K>)
+    std::optional<TObject> findById(const CSVFileIndex &index, const K &key) const;
+#endif
+
+    // Parses the file into columns laid out per the Arrow C data interface, exported as a struct array (one child per
+    // column, named after the header) with its schema. The consumer takes ownership and calls the release callbacks;
+    // buffers are handed over without copies. Needs one type per column. Missing or unconvertible cells are nulls.
+    void parseIntoArrow(const std::string &filename, ArrowArray *array, ArrowSchema *schema)
+        requires(CSVArrowColumn<Types> && ...);
+
+    // Keeps the rows of the file in memory, LZ-compressed in blocks, instead of objects. Rows are parsed on demand
+    // with materialize(); the raw text takes about half its size or less (see CSVLZ).
+    CSVCompressedRows compressRows(const std::string &filename);
+
+    // Parses row 'row' of the store (0-based, empty lines excluded) with the store's dialect and columns.
+    // Use one cursor per thread; reading rows in order decompresses each block once. The parser is only read, so
+    // threads may share it. Throws std::out_of_range if 'row' is not below rows().
+    TObject materialize(CSVCompressedRows::Cursor &cursor, std::size_t row) const;
+
+    // Rewrites the file in a canonical dialect, without converting any value: input dialect as detected (or set),
+    // output as in 'options', with the columns projected and reordered by name, minimal quoting and one line ending.
+    // Empty lines are dropped and short rows are padded with empty fields. Chunks are transcoded on setThreads()
+    // workers and written in order. Throws InvalidDialect if the output delimiter and quote are equal or a line break,
+    // and UnknownColumn for a projected column missing from the header. Returns the number of data rows written.
+    std::size_t normalizeFile(const std::string &input, const std::string &output, const CSVNormalizeOptions &options = {});
+
+    // Validates every row without constructing objects: column count, quoting, conversion of each field to the type
+    // of its column and, with setValidateUTF8(true), encoding. Runs on setThreads() workers. Header and dialect
+    // detection errors are thrown as by parseObjectsFromFile().
+    CSVLintReport lintFile(const std::string &filename, std::size_t max_errors = 1000);
+
+    // Resumable parse of one file, driven by step(budget) calls (see openSession()).
+    template<typename Result>
+    class ParseSession;
+
+    // Opens a resumable parse session: no row is read until step() is called. The parser must outlive the session.
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+    ParseSession<Container<K, TObject>> openSession(const std::string &filename);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    ParseSession<Container<TObject>> openSession(const std::string &filename);
+
+    // Low-overhead batch for many small files: the dialect is detected once (or taken from the parser settings), each
+    // worker reuses one reader buffer, nothing is printed and failures are reported per file instead of thrown.
+    // All files must share the dialect and header layout. Uses setThreads() workers (0: all cores).
+    template<template<typename...> class Container, typename K>
+        requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+    CSVBatchResult<Container<K, TObject>> parseSmallFiles(const std::vector<std::string> &filenames);
+
+    template<template<typename> class Container>
+        requires AllowedContainer<Container<TObject>>
+    CSVBatchResult<Container<TObject>> parseSmallFiles(const std::vector<std::string> &filenames);
+
+    void inspect(const auto& container) {
+        try {
+            for (const auto& head : header) {
+                std::cout << head << "\t";
+            }
+            std::cout << std::endl;
+            for (const auto& unit : container) {
+                try {
+                    if constexpr (is_unordered_map<std::decay_t<decltype(container)>>::value) {
+                        std::cout << unit.second << std::endl;
+                    } else {
+                        std::cout << unit << std::endl;
+                    }
+                } catch (std::exception&) {
+                    throw InsufficientOverload(typeid(unit).name());
+                }
+            }
+        } catch (InsufficientOverload&) {
+            throw;
+        }
+    }
+
+    void inspect_pointers(const auto& container) {
+        try {
+            for (const auto& head : header) {
+                std::cout << head << "\t";
+            }
+            std::cout << std::endl;
+            for (const auto& unit : container) {
+                try {
+                    if constexpr (is_unordered_map<std::decay_t<decltype(container)>>::value) {
+                        std::cout << *unit.second << std::endl;
+                    } else {
+                        std::cout << *unit << std::endl;
+                    }
+                } catch (std::exception&) {
+                    throw InsufficientOverload(typeid(unit).name());
+                }
+            }
+        } catch (InsufficientOverload&) {
+            throw;
+        }
+    }
+
+    ~CSVParser() = default;
+};
 
 
 /* ======= Header checker ======= */
 
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
-std::pair<bool, char> CSVParser<TObject, Types...>::trust_header(const std::string &filename) {
-    std::ifstream file(filename);
+std::pair<bool, char> CSVParser<TObject, Types...>::trust_header(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw FileOpenException(filename);
+    }
+
+    int current_row(1);
+    std::string row;
+
+    do {
+        std::getline(file, row);
+        current_row++;
+    } while (current_row == header_row);
+    trimLineEnding(row);
+
+    // If the delimiter is defined...
+    if (delimiter != '\0') {
+        std::vector<std::string_view> fields;
+        tokenizer().split(row.data(), row.data() + row.size(), fields);
+        std::vector<std::string> try_header(fields.begin(), fields.end());
+
+        // If the custom header is not defined, set the default header from CSV file.
+        if (header.empty()) {
+            try {
+                setHeader(try_header);
+                return {false, delimiter};
+            } catch (WrongHeaderLength&) {
+                throw;
+            }
+        }
+
+        // If the custom header is defined, the new custom header must be of same size.
+        if (try_header.size() == header.size()) {
+            return {true, delimiter};
+        }
+
+        throw WrongHeaderByDelimiter(filename, try_header.size(), header.size(), header_row, tokenizer().delimiterText());
+    }
+
+    // Else, if the delimiter is not defined...
+    // Candidates are split with the escape character, unless they clash with it (tokenizer() then rejects the dialect).
+    const auto candidateTokenizer = [this](const char candidate_delimiter) {
+        CSVTokenizer candidate{candidate_delimiter, quote};
+        candidate.escape = escape != candidate_delimiter && escape != quote ? escape : '\0';
+        return candidate;
+    };
+    std::unordered_map<char, std::pair<int, std::vector<std::string> > > detected_values;
+    for (const char current_delimiter: default_delimiters) {
+        std::string candidate = row;
+        std::vector<std::string_view> fields;
+        candidateTokenizer(current_delimiter).split(candidate.data(), candidate.data() + candidate.size(), fields);
+        std::vector<std::string> try_header(fields.begin(), fields.end());
+
+        if (try_header.size() == header.size() && !header.empty()) {
+            setHeader(try_header);
+            return {true, current_delimiter};
+        }
+
+        detected_values[current_delimiter] = {try_header.size(), try_header};
+    }
+
+    // If no header is defined, all default delimiters will be checked,
+    // and the parser will assume the number of columns in the CSV
+    // matches the number of fields (arity) of the object.
+    if (header.empty()) {
+        // Read next row (blank rows are skipped, as they are when parsing)
+        int length(0);
+        char good_delimiter('\0');
+        do {
+            std::getline(file, row);
+            trimLineEnding(row);
+        } while (row.empty() && file);
+        std::vector<std::pair<int, char> > detected_values_next_row;
+
+        for (const char current_delimiter: default_delimiters) {
+            std::string candidate = row;
+            std::vector<std::string_view> fields;
+            candidateTokenizer(current_delimiter).split(candidate.data(), candidate.data() + candidate.size(), fields);
+            const int value_counter = row.empty() ? 0 : static_cast<int>(fields.size());
+
+            if (detected_values[current_delimiter].first == value_counter
+                && value_counter > 0
+                && checkMaxArgs(value_counter)) {
+                good_delimiter = current_delimiter;
+                length = value_counter;
+                break;
+            }
+        }
+
+        if (length) {
+            try {
+                setHeader(detected_values[good_delimiter].second);
+                return {false, good_delimiter};
+            } catch (WrongHeaderLength&) {
+                throw;
+            }
+        }
+    }
+
+    throw WrongHeaderByAllDelimiters(filename, detected_values, header.size(), header_row);
+}
+
+
+/* ======= Row loop shared by all parsing functions ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+typename CSVParser<TObject, Types...>::DataSection CSVParser<TObject, Types...>::openDataSection(const std::string &filename) {
+    CSVTrace::Span span(trace, "sniff header");
+    std::string row;
+    std::ifstream file(filename, std::ios::binary);
+    initialize(row, file, filename);
+
+    // initialize() stops right after the header row: the data section starts here.
+    DataSection section{filename, 0, 0, tokenizer()};
+    const bool has_data = file.good();
+    section.begin = has_data ? static_cast<std::uint64_t>(file.tellg()) : 0;
+    file.clear();
+    file.seekg(0, std::ios::end);
+    section.end = static_cast<std::uint64_t>(file.tellg());
+    section.begin = has_data ? section.begin : section.end;
+
+    return section;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result, typename Inserter>
+void CSVParser<TObject, Types...>::parseRows(const std::string &filename, Result &result, Inserter &&insert) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+
+    resetStats(filename, section.end - section.begin);
+
+    if constexpr (std::is_copy_constructible_v<TObject>) {
+        if (incremental && !checkpoint_every && !arena_target) {
+            parseRowsIncremental(section, result, insert);
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return;
+        }
+    }
+
+    // XXH64 cannot be combined across chunks, so it keeps the parse on the calling thread.
+    if (maxThreads() > 1 && stats.bytes >= parallel_min_bytes && !checkpoint_every && checksum_type != CSVChecksum::XXH64) {
+        parseRowsParallel(section, result, insert);
+    } else {
+        CSVChecksumState checksum(checksum_type);
+        if (checksum_type != CSVChecksum::None) {
+            checksumPrefix(section, checksum);
+        }
+
+        const RangeResult base{static_cast<std::size_t>(header_row), 0, 0, 0, {}};
+        const RangeResult range = parseRange(section, section.begin, section.end, [&](TObject &&object) {
+            insert(result, std::move(object));
+        }, &base, checksum_type != CSVChecksum::None ? &checksum : nullptr);
+        if (range.invalid_line) {
+            throw InvalidEncoding(filename, header_row + range.invalid_line);
+        }
+        stats.rows = range.rows;
+        stats.perf = range.perf;
+
+        if (checksum_type != CSVChecksum::None) {
+            verifyChecksum(filename, range.checksum);
+        }
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Emit>
+typename CSVParser<TObject, Types...>::RangeResult CSVParser<TObject, Types...>::parseRange(
+    const DataSection &section, const std::uint64_t begin, const std::uint64_t end, Emit &&emit,
+    const RangeResult *checkpoint_base, CSVChecksumState *checksum) const {
+    const std::size_t every = checkpoint_base ? checkpoint_every : 0;
+    RangeResult result;
+    CSVTrace::Span span(trace, "parse chunk");
+    CSVBlockReader reader;
+    reader.open(section.filename, begin, end);
+    reader.setChecksum(checksum);
+    reader.setTrace(trace);
+
+    std::vector<std::string_view> fields;
+    fields.reserve(header.size());
+    char *line_begin, *line_end;
+
+    const CSVPerfCounters *counters = perf_counters ? CSVPerfCounters::forThread() : nullptr;
+    const CSVPerfCounts range_start = counters ? counters->read() : CSVPerfCounts{};
+    // Sampled rows are 1 to 2 * sample_every - 1 rows apart: a fixed stride of 64 would line up with the power-of-two
+    // growth of vectors and measure every reallocation in the insert stage.
+    std::size_t next_sample = 0;
+    auto sample_state = static_cast<std::uint32_t>(begin) ^ 0x9E3779B9u;
+
+    while (reader.nextLine(line_begin, line_end)) {
+        ++result.lines;
+        if (line_begin == line_end) {
+            continue;
+        }
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            result.invalid_line = result.lines;
+            break;
+        }
+        if (counters && result.rows == next_sample) {
+            sample_state = sample_state * 1664525u + 1013904223u;
+            next_sample += 1 + (sample_state >> 16) % (2 * CSVPerfStats::sample_every - 1);
+            const CSVPerfCounts before = counters->read();
+            section.tokenizer.split(line_begin, line_end, fields);
+            const CSVPerfCounts split = counters->read();
+            TObject object = this->objectFromFields(fields);
+            const CSVPerfCounts converted = counters->read();
+            emit(std::move(object));
+            const CSVPerfCounts inserted = counters->read();
+            result.perf.tokenize += counters->stage(before, split);
+            result.perf.convert += counters->stage(split, converted);
+            result.perf.insert += counters->stage(converted, inserted);
+            ++result.perf.sampled_rows;
+        } else {
+            emit(this->parseObjectFromRow(section.tokenizer, line_begin, line_end, fields));
+        }
+        ++result.rows;
+
+        if (every && result.rows % every == 0) {
+            emitCheckpoint(section, reader.offset(), checkpoint_base->lines + result.lines, checkpoint_base->rows + result.rows);
+        }
+    }
+
+    if (checksum) {
+        result.checksum = checksum->value();
+    }
+    if (counters) {
+        // Stages are extrapolated per range, so ranges of different threads add up.
+        result.perf.available = true;
+        result.perf.total = counters->read() - range_start;
+        result.perf.tokenize = result.perf.tokenize.scaled(result.rows, result.perf.sampled_rows);
+        result.perf.convert = result.perf.convert.scaled(result.rows, result.perf.sampled_rows);
+        result.perf.insert = result.perf.insert.scaled(result.rows, result.perf.sampled_rows);
+    }
+    span.setArg("rows", result.rows);
+    return result;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::checksumPrefix(const DataSection &section, CSVChecksumState &checksum) {
+    std::ifstream file(section.filename, std::ios::binary);
+    std::string prefix(static_cast<std::size_t>(section.begin), '\0');
+    file.read(prefix.data(), static_cast<std::streamsize>(prefix.size()));
+    checksum.update(prefix.data(), prefix.data() + file.gcount());
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::verifyChecksum(const std::string &filename, const std::uint64_t checksum) {
+    stats.checksum_type = checksum_type;
+    stats.checksum = checksum;
+    if (expected_checksum && *expected_checksum != checksum) {
+        throw ChecksumMismatch(filename, CSVChecksumState::name(checksum_type), *expected_checksum, checksum);
+    }
+}
+
+
+/* ======= Adaptive parallel parsing ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result>
+void CSVParser<TObject, Types...>::mergeInto(Result &into, Result &&from) {
+    if (into.empty()) {
+        into = std::move(from);
+    } else if constexpr (requires { into.merge(from); }) {
+        into.merge(from);
+    } else {
+        into.insert(into.end(), std::make_move_iterator(from.begin()), std::make_move_iterator(from.end()));
+    }
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+double CSVParser<TObject, Types...>::sampleRowLength(const std::string &filename, const std::uint64_t begin, const std::uint64_t end) {
+    std::ifstream file(filename, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(begin));
+
+    std::string sample(static_cast<std::size_t>(std::min<std::uint64_t>(end - begin, 64 << 10)), '\0');
+    file.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+    sample.resize(static_cast<std::size_t>(file.gcount()));
+
+    const std::size_t lines = CSVKernels::countByte(sample.data(), sample.data() + sample.size(), '\n');
+    return static_cast<double>(sample.size()) / static_cast<double>(std::max<std::size_t>(lines, 1));
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+std::vector<std::uint64_t> CSVParser<TObject, Types...>::planChunks(
+    const std::string &filename, const std::uint64_t begin, const std::uint64_t end, const std::uint64_t size) {
+    std::vector<std::uint64_t> boundaries{begin};
+    std::ifstream file(filename, std::ios::binary);
+    char probe[4096];
+
+    for (std::uint64_t nominal = begin + size; nominal < end; nominal = boundaries.back() + size) {
+        // The chunk ends after the first newline found from the nominal offset on.
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(nominal));
+        std::uint64_t boundary = end;
+
+        for (std::uint64_t offset = nominal; offset < end && file;) {
+            file.read(probe, sizeof(probe));
+            const auto received = static_cast<std::size_t>(file.gcount());
+            const char *newline = CSVKernels::findStructural(probe, probe + received, '\n', '\n');
+            if (newline != probe + received) {
+                boundary = offset + static_cast<std::uint64_t>(newline - probe) + 1;
+                break;
+            }
+            offset += received;
+        }
+
+        if (boundary >= end) {
+            break;
+        }
+        boundaries.push_back(boundary);
+    }
+
+    boundaries.push_back(end);
+    return boundaries;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+std::uint64_t CSVParser<TObject, Types...>::chooseChunkSize(const DataSection &section, const unsigned max_threads) const {
+    if (chunk_size_preference) {
+        return chunk_size_preference;
+    }
+    const auto by_rows = static_cast<std::uint64_t>(sampleRowLength(section.filename, section.begin, section.end) * target_rows_per_chunk);
+    // At least 4 chunks per thread, so the tail stays balanced.
+    return std::clamp(std::min<std::uint64_t>(by_rows, (section.end - section.begin) / (4u * max_threads)), min_chunk_size, max_chunk_size);
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result, typename Inserter>
+void CSVParser<TObject, Types...>::parseRowsParallel(const DataSection &section, Result &result, Inserter &&insert) {
+    const unsigned max_threads = maxThreads();
+    const std::uint64_t chunk_size = chooseChunkSize(section, max_threads);
+    std::vector<std::uint64_t> boundaries;
+    {
+        CSVTrace::Span span(trace, "plan chunks");
+        boundaries = planChunks(section.filename, section.begin, section.end, chunk_size);
+    }
+    const std::size_t chunk_count = boundaries.size() - 1;
+
+    // Ordered: one buffer per chunk, merged in file order. Relaxed: one container per worker, merged at the end.
+    std::vector<std::vector<TObject>> chunk_objects(ordered ? chunk_count : 0);
+    std::vector<Result> worker_results(ordered ? 0 : max_threads);
+    std::vector<RangeResult> chunk_results(chunk_count);
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<unsigned> active_limit{std::min(2u, max_threads)};
+    std::exception_ptr failure;
+
+    std::mutex mutex;
+    std::condition_variable chunk_done;
+    std::size_t done_chunks = 0;
+    std::uint64_t done_bytes = 0;
+
+    auto work = [&](const unsigned worker) {
+        if (trace) {
+            trace->nameThread(std::format("worker {}", worker));
+        }
+        while (worker < active_limit.load()) {
+            const std::size_t chunk = next_chunk.fetch_add(1);
+            if (chunk >= chunk_count) {
+                return;
+            }
+
+            // With an arena, each chunk stores its strings in its own arena, spliced into the result's one.
+            CSVStringArena chunk_arena;
+            try {
+                CSVStringArena::Scope arena_scope(arena_target ? &chunk_arena : nullptr);
+                CSVChecksumState checksum(checksum_type);
+                chunk_results[chunk] = parseRange(section, boundaries[chunk], boundaries[chunk + 1], [&](TObject &&object) {
+                    if (ordered) {
+                        chunk_objects[chunk].push_back(std::move(object));
+                    } else {
+                        insert(worker_results[worker], std::move(object));
+                    }
+                }, nullptr, checksum_type != CSVChecksum::None ? &checksum : nullptr);
+            } catch (...) {
+                std::lock_guard lock(mutex);
+                failure = failure ? failure : std::current_exception();
+                next_chunk.store(chunk_count);
+            }
+
+            std::lock_guard lock(mutex);
+            if (arena_target) {
+                arena_target->splice(std::move(chunk_arena));
+            }
+            ++done_chunks;
+            done_bytes += boundaries[chunk + 1] - boundaries[chunk];
+            chunk_done.notify_one();
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned worker = 0; worker < active_limit.load(); ++worker) {
+        workers.emplace_back(work, worker);
+    }
+    unsigned peak_threads = active_limit.load();
+
+    // The calling thread tunes the thread count: every window of one chunk per thread, the throughput is compared
+    // to the previous window. Threads are doubled while it keeps growing; a drop reverts the last step.
+    {
+        std::unique_lock lock(mutex);
+        bool tuning = max_threads > active_limit.load();
+        double last_rate = 0;
+        unsigned last_limit = active_limit.load();
+        std::size_t window_chunks = 0;
+        std::uint64_t window_bytes = 0;
+        auto window_start = std::chrono::steady_clock::now();
+
+        while (done_chunks < chunk_count && !failure) {
+            chunk_done.wait(lock);
+            if (!tuning || done_chunks - window_chunks < active_limit.load()) {
+                continue;
+            }
+
+            const auto now = std::chrono::steady_clock::now();
+            const double rate = static_cast<double>(done_bytes - window_bytes) /
+                                std::max(std::chrono::duration<double>(now - window_start).count(), 1e-9);
+
+            if (last_rate == 0 || rate > last_rate * 1.15) {
+                const unsigned current = active_limit.load();
+                const unsigned next = std::min(max_threads, current * 2);
+                last_limit = current;
+                last_rate = rate;
+                active_limit.store(next);
+                for (unsigned worker = current; worker < next; ++worker) {
+                    workers.emplace_back(work, worker);
+                }
+                peak_threads = std::max(peak_threads, next);
+                tuning = next < max_threads;
+            } else {
+                if (rate < last_rate * 0.9) {
+                    active_limit.store(last_limit);   // Workers above the limit leave after their current chunk.
+                }
+                tuning = false;
+            }
+
+            window_chunks = done_chunks;
+            window_bytes = done_bytes;
+            window_start = now;
+        }
+    }
+
+    for (auto &worker: workers) {
+        worker.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+
+    std::size_t line_base = header_row;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        if (chunk_results[chunk].invalid_line) {
+            throw InvalidEncoding(section.filename, line_base + chunk_results[chunk].invalid_line);
+        }
+        line_base += chunk_results[chunk].lines;
+        stats.rows += chunk_results[chunk].rows;
+        stats.perf += chunk_results[chunk].perf;
+    }
+
+    // Per-chunk CRC32C values are combined in file order, after the header bytes.
+    if (checksum_type == CSVChecksum::CRC32C) {
+        CSVChecksumState prefix(checksum_type);
+        checksumPrefix(section, prefix);
+        auto crc = static_cast<std::uint32_t>(prefix.value());
+        for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+            crc = CSVChecksumState::combineCRC32C(crc, static_cast<std::uint32_t>(chunk_results[chunk].checksum),
+                                                  boundaries[chunk + 1] - boundaries[chunk]);
+        }
+        verifyChecksum(section.filename, crc);
+    }
+
+    if (ordered) {
+        CSVTrace::Span span(trace, "insert");
+        for (auto &objects: chunk_objects) {
+            for (auto &object: objects) {
+                insert(result, std::move(object));
+            }
+            std::vector<TObject>().swap(objects);
+        }
+        span.setArg("chunks", chunk_count);
+    } else {
+        CSVTrace::Span span(trace, "merge");
+        for (auto &worker_result: worker_results) {
+            mergeInto(result, std::move(worker_result));
+        }
+        span.setArg("workers", worker_results.size());
+    }
+
+    stats.chunks = chunk_count;
+    stats.chunk_size = chunk_size;
+    stats.threads = peak_threads;
+}
+
+
+/* ======= Incremental reparse ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+std::vector<typename CSVParser<TObject, Types...>::ContentChunk> CSVParser<TObject, Types...>::planContentChunks(
+    const DataSection &section, CSVChecksumState *checksum) const {
+    std::vector<ContentChunk> chunks;
+    CSVBlockReader reader;
+    reader.open(section.filename, section.begin, section.end);
+    reader.setChecksum(checksum);
+
+    ContentChunk chunk{section.begin, section.begin, 0, 0};
+    CSVXXH64 hash;
+    char *line_begin, *line_end;
+
+    while (reader.nextLine(line_begin, line_end)) {
+        // The line ending is hashed as a plain '\n': CRLF and LF files give the same objects.
+        hash.update(line_begin, line_end);
+        hash.update("\n", "\n" + 1);
+        ++chunk.lines;
+        chunk.end = reader.offset();
+
+        const bool content_cut = chunk.lines >= min_content_chunk_lines &&
+                                 (CSVKernels::crc32c(0, line_begin, line_end) & content_chunk_mask) == 0;
+        if (content_cut || chunk.end - chunk.begin >= max_content_chunk_bytes) {
+            chunk.hash = hash.digest();
+            chunks.push_back(chunk);
+            chunk = {chunk.end, chunk.end, 0, 0};
+            hash = {};
+        }
+    }
+    if (chunk.lines) {
+        chunk.hash = hash.digest();
+        chunks.push_back(chunk);
+    }
+
+    return chunks;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result, typename Inserter>
+void CSVParser<TObject, Types...>::parseRowsIncremental(const DataSection &section, Result &result, Inserter &&insert) {
+    // Objects depend on the dialect and the header, so a change of either invalidates the whole cache.
+    std::string dialect = section.tokenizer.delimiterText() + std::string{'\n', section.tokenizer.quote, section.tokenizer.escape,
+                                                                         static_cast<char>(validate_utf8)};
+    for (const auto &column: header) {
+        dialect += '\n' + column;
+    }
+    if (dialect != chunk_cache_dialect) {
+        chunk_cache.clear();
+        chunk_cache_dialect = std::move(dialect);
+    }
+
+    // XXH64 is only valid computed in one pass, which the planning scan provides.
+    CSVChecksumState checksum(checksum_type);
+    if (checksum_type != CSVChecksum::None) {
+        checksumPrefix(section, checksum);
+    }
+    std::vector<ContentChunk> chunks;
+    {
+        CSVTrace::Span span(trace, "hash chunks");
+        chunks = planContentChunks(section, checksum_type != CSVChecksum::None ? &checksum : nullptr);
+        span.setArg("chunks", chunks.size());
+    }
+
+    // The cache is only updated once every missing chunk parsed successfully.
+    std::unordered_map<std::uint64_t, CachedChunk> next_cache;
+    std::vector<std::size_t> missing;
+    for (std::size_t chunk = 0; chunk < chunks.size(); ++chunk) {
+        if (!chunk_cache.contains(chunks[chunk].hash) && next_cache.try_emplace(chunks[chunk].hash).second) {
+            missing.push_back(chunk);
+        }
+    }
+
+    std::vector<RangeResult> missing_results(missing.size());
+    CSVWorkStealingPool pool(static_cast<unsigned>(std::min<std::size_t>(maxThreads(), std::max<std::size_t>(missing.size(), 1))));
+    for (std::size_t index = 0; index < missing.size(); ++index) {
+        pool.push([this, &section, &chunks, &missing, &missing_results, &next_cache, index] {
+            const ContentChunk &chunk = chunks[missing[index]];
+            CachedChunk &cached = next_cache.at(chunk.hash);
+            missing_results[index] = parseRange(section, chunk.begin, chunk.end, [&cached](TObject &&object) {
+                cached.objects.push_back(std::move(object));
+            });
+            cached.lines = chunk.lines;
+        });
+    }
+    pool.run();
+
+    std::size_t line_base = header_row;
+    for (std::size_t index = 0, chunk = 0; index < missing.size(); ++index) {
+        for (; chunk < missing[index]; ++chunk) {
+            line_base += chunks[chunk].lines;
+        }
+        if (missing_results[index].invalid_line) {
+            throw InvalidEncoding(section.filename, line_base + missing_results[index].invalid_line);
+        }
+        stats.perf += missing_results[index].perf;
+    }
+
+    for (const ContentChunk &chunk: chunks) {
+        if (!next_cache.contains(chunk.hash)) {
+            next_cache.emplace(chunk.hash, std::move(chunk_cache.at(chunk.hash)));
+            ++stats.reused_chunks;
+        }
+    }
+
+    {
+        CSVTrace::Span span(trace, "insert");
+        for (const ContentChunk &chunk: chunks) {
+            for (const TObject &object: next_cache.at(chunk.hash).objects) {
+                insert(result, TObject(object));
+                ++stats.rows;
+            }
+        }
+        span.setArg("chunks", chunks.size());
+    }
+
+    // Only the chunks of this version of the file are kept.
+    chunk_cache = std::move(next_cache);
+    stats.chunks = chunks.size();
+    stats.threads = pool.threads();
+    if (checksum_type != CSVChecksum::None) {
+        verifyChecksum(section.filename, checksum.value());
+    }
+}
+
+
+/* ======= Shared-memory dataset publishing ======= */
+
+#ifdef CSV_PARSER_POSIX
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::publishDataset(const std::string &filename, const std::string &name)
+    requires(CSVSharedColumn<Types> && ...) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    if (header.size() != sizeof...(Types)) {
+        throw InvalidDataset(name, std::format("needs one type per column, the header has {} columns", header.size()));
+    }
+    resetStats(filename, section.end - section.begin);
+
+    typename CSVSharedDataset<Types...>::Builder builder;
+    CSVBlockReader reader;
+    reader.open(section.filename, section.begin, section.end);
+    std::vector<std::string_view> fields;
+    fields.reserve(header.size());
+    char *line_begin, *line_end;
+    std::size_t line = header_row;
+
+    while (reader.nextLine(line_begin, line_end)) {
+        ++line;
+        if (line_begin == line_end) {
+            continue;
+        }
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            throw InvalidEncoding(filename, line);
+        }
+        section.tokenizer.split(line_begin, line_end, fields);
+        builder.append(fields);
+        ++stats.rows;
+    }
+
+    builder.publish(name);
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/* ======= On-disk key index ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename K>
+    requires(HasIdMember<TObject, K> && CSVIndexKey<K>)
+void CSVParser<TObject, Types...>::buildIndex(const std::string &filename, const std::string &index_path) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    resetStats(filename, section.end - section.begin);
+
+    std::vector<CSVFileIndex::Slot> entries;
+    CSVBlockReader reader;
+    reader.open(section.filename, section.begin, section.end);
+    std::vector<std::string_view> fields;
+    fields.reserve(header.size());
+    char *line_begin, *line_end;
+    std::size_t line = header_row;
+
+    for (std::uint64_t offset = reader.offset(); reader.nextLine(line_begin, line_end); offset = reader.offset()) {
+        ++line;
+        if (line_begin == line_end) {
+            continue;
+        }
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            throw InvalidEncoding(filename, line);
+        }
+        const K key = parseObjectFromRow(section.tokenizer, line_begin, line_end, fields).getId();
+        entries.push_back({CSVFileIndex::hashKey(key), offset});
+    }
+
+    CSVFileIndex::write(filename, index_path.empty() ? CSVFileIndex::defaultPath(filename) : index_path, entries,
+                        section.tokenizer, header_row, header);
+    stats.rows = entries.size();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename K>
+    requires(HasIdMember<TObject, K> && CSVIndexKey<K>)
+std::optional<TObject> CSVParser<TObject, Types...>::findById(const CSVFileIndex &index, const K &key) const {
+    const CSVTokenizer &splitter = index.tokenizer();
+    std::optional<TObject> found;
+    std::vector<std::string_view> fields;
+
+    // Objects of a unique type take as many cells as the header has columns.
+    const auto *parser = this;
+    std::optional<CSVParser> restored;
+    if constexpr (sizeof...(Types) == 1) {
+        if (header.empty()) {
+            restored.emplace(index.columns());
+            parser = &*restored;
+        }
+    }
+
+    index.probe(CSVFileIndex::hashKey(key), [&](const std::uint64_t offset) {
+        std::string line = index.readLine(offset);
+        TObject object = parser->parseObjectFromRow(splitter, line.data(), line.data() + line.size(), fields);
+        if (object.getId() == key) {
+            found = std::move(object);
+        }
+    });
+    return found;
+}
+#endif
+
+
+/* ======= Arrow export ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::parseIntoArrow(const std::string &filename, ArrowArray *array, ArrowSchema *schema)
+    requires(CSVArrowColumn<Types> && ...) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    if (header.size() != sizeof...(Types)) {
+        throw WrongHeaderLength(sizeof...(Types), header);
+    }
+    resetStats(filename, section.end - section.begin);
+
+    std::tuple<CSVArrowColumnBuilder<Types>...> columns;
+    CSVBlockReader reader;
+    reader.open(section.filename, section.begin, section.end);
+    std::vector<std::string_view> fields;
+    fields.reserve(header.size());
+    char *line_begin, *line_end;
+    std::size_t line = header_row;
+
+    while (reader.nextLine(line_begin, line_end)) {
+        ++line;
+        if (line_begin == line_end) {
+            continue;
+        }
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            throw InvalidEncoding(filename, line);
+        }
+        section.tokenizer.split(line_begin, line_end, fields);
+        [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+            (std::get<Index>(columns).append(Index < fields.size() ? fields[Index] : std::string_view{}, Index < fields.size()), ...);
+        }(std::index_sequence_for<Types...>{});
+        ++stats.rows;
+    }
+
+    std::vector<ArrowArray *> child_arrays;
+    std::vector<ArrowSchema *> child_schemas;
+    [&]<std::size_t... Index>(std::index_sequence<Index...>) {
+        ((child_arrays.push_back(new ArrowArray{}), child_schemas.push_back(new ArrowSchema{}),
+          std::get<Index>(columns).exportTo(child_arrays.back(), child_schemas.back(), header[Index])), ...);
+    }(std::index_sequence_for<Types...>{});
+
+    std::vector<CSVArrowBuffer> struct_buffers(1);     // No validity bitmap: every row is valid.
+    CSVArrowExport::array(array, static_cast<std::int64_t>(stats.rows), 0, std::move(struct_buffers), std::move(child_arrays));
+    CSVArrowExport::schema(schema, "+s", "", 0, std::move(child_schemas));
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+/* ======= Compressed row store ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+CSVCompressedRows CSVParser<TObject, Types...>::compressRows(const std::string &filename) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    resetStats(filename, section.end - section.begin);
+
+    CSVCompressedRows store(section.tokenizer, header);
+    CSVBlockReader reader;
+    reader.open(section.filename, section.begin, section.end);
+    char *line_begin, *line_end;
+    std::size_t line = header_row;
+
+    while (reader.nextLine(line_begin, line_end)) {
+        ++line;
+        if (line_begin == line_end) {
+            continue;
+        }
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            throw InvalidEncoding(filename, line);
+        }
+        store.append(line_begin, line_end);
+    }
+    store.flush();
+
+    stats.rows = store.rows();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return store;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+TObject CSVParser<TObject, Types...>::materialize(CSVCompressedRows::Cursor &cursor, const std::size_t row) const {
+    const std::string_view text = cursor.row(row);
+    const CSVCompressedRows &store = cursor.source();
+
+    // The tokenizer unescapes in place: the row is copied so the cursor's block stays intact for the next rows.
+    // Both buffers are reused across calls on the same thread.
+    thread_local std::string line;
+    thread_local std::vector<std::string_view> fields;
+    line.assign(text);
+    store.tokenizer().split(line.data(), line.data() + line.size(), fields);
+    return objectFromFields(fields, store.columns().size());
+}
+
+
+/* ======= CSV-to-CSV normalization ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+std::size_t CSVParser<TObject, Types...>::normalizeFile(const std::string &input, const std::string &output,
+                                                        const CSVNormalizeOptions &options) {
+    const auto start = std::chrono::steady_clock::now();
+    // The output must read back as the same fields: checked before the output file is created.
+    const CSVTokenizer output_dialect{options.delimiter, options.quote};
+    if (const char *reason = output_dialect.invalidReason()) {
+        throw InvalidDialect(output_dialect.delimiterText(), options.quote, '\0', reason);
+    }
+    const DataSection section = openDataSection(input);
+    resetStats(input, section.end - section.begin);
+
+    // The header row is read again as text: header cells may be quoted or contain the delimiter.
+    std::vector<std::string> names = header;
+    if (!custom_header) {
+        std::ifstream file(input, std::ios::binary);
+        std::string row;
+        for (int current = 0; current < header_row && std::getline(file, row); ++current) {
+        }
+        trimLineEnding(row);
+        std::vector<std::string_view> cells;
+        section.tokenizer.split(row.data(), row.data() + row.size(), cells);
+        names.assign(cells.begin(), cells.end());
+    }
+
+    std::vector<std::size_t> projection;
+    if (options.columns.empty()) {
+        for (std::size_t column = 0; column < names.size(); ++column) {
+            projection.push_back(column);
+        }
+    }
+    for (const std::string &column: options.columns) {
+        const auto found = std::ranges::find(names, column);
+        if (found == names.end()) {
+            throw UnknownColumn(input, column);
+        }
+        projection.push_back(static_cast<std::size_t>(found - names.begin()));
+    }
+
+    std::ofstream file(output, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw FileOpenException(output);
+    }
+    if (options.header) {
+        std::string row;
+        writeNormalizedRow(std::vector<std::string_view>(names.begin(), names.end()), projection, options, row);
+        file << row;
+    }
+
+    const unsigned max_threads = maxThreads();
+    const bool parallel = max_threads > 1 && stats.bytes >= parallel_min_bytes;
+    const std::uint64_t chunk_size = parallel ? chooseChunkSize(section, max_threads) : 0;
+    const std::vector<std::uint64_t> boundaries = parallel
+                                                      ? planChunks(section.filename, section.begin, section.end, chunk_size)
+                                                      : std::vector<std::uint64_t>{section.begin, section.end};
+    const std::size_t chunk_count = boundaries.size() - 1;
+
+    // Chunks are transcoded in windows of a few per thread, so output buffers stay bounded, and written in order.
+    const std::size_t window = std::max<std::size_t>(1, 4u * max_threads);
+    std::vector<std::string> outputs(std::min(window, chunk_count));
+    std::vector<std::size_t> rows(outputs.size());
+    for (std::size_t first = 0; first < chunk_count; first += window) {
+        const std::size_t last = std::min(first + window, chunk_count);
+        CSVWorkStealingPool pool(static_cast<unsigned>(std::min<std::size_t>(max_threads, last - first)));
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            pool.push([&, chunk] {
+                std::string &out = outputs[chunk - first];
+                std::size_t &written = rows[chunk - first];
+                out.clear();
+                written = 0;
+
+                CSVBlockReader reader;
+                reader.open(section.filename, boundaries[chunk], boundaries[chunk + 1]);
+                std::vector<std::string_view> fields;
+                char *line_begin, *line_end;
+                while (reader.nextLine(line_begin, line_end)) {
+                    if (line_begin == line_end) {
+                        continue;
+                    }
+                    section.tokenizer.split(line_begin, line_end, fields);
+                    writeNormalizedRow(fields, projection, options, out);
+                    ++written;
+                }
+            });
+        }
+        pool.run();
+        stats.threads = std::max(stats.threads, pool.threads());
+
+        for (std::size_t chunk = first; chunk < last; ++chunk) {
+            file.write(outputs[chunk - first].data(), static_cast<std::streamsize>(outputs[chunk - first].size()));
+            stats.rows += rows[chunk - first];
+        }
+    }
+
+    if (!file.flush()) {
+        throw FileOpenException(output);
+    }
+    stats.chunks = chunk_count;
+    stats.chunk_size = chunk_size;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats.rows;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::writeNormalizedRow(const std::vector<std::string_view> &fields, const std::vector<std::size_t> &projection,
+                                                      const CSVNormalizeOptions &options, std::string &out) {
+    const char specials[] = {options.delimiter, options.quote, '\n', '\r'};
+    for (std::size_t column = 0; column < projection.size(); ++column) {
+        if (column) {
+            out.push_back(options.delimiter);
+        }
+        if (projection[column] >= fields.size()) {
+            continue;
+        }
+
+        const std::string_view field = fields[projection[column]];
+        if (field.find_first_of(std::string_view(specials, sizeof(specials))) == std::string_view::npos) {
+            out.append(field);
+            continue;
+        }
+        out.push_back(options.quote);
+        for (const char symbol: field) {
+            if (symbol == options.quote) {
+                out.push_back(options.quote);
+            }
+            out.push_back(symbol);
+        }
+        out.push_back(options.quote);
+    }
+    out.append(options.crlf ? "\r\n" : "\n");
+}
+
+
+/* ======= Validation without object construction ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+CSVLintReport CSVParser<TObject, Types...>::lintFile(const std::string &filename, const std::size_t max_errors) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    resetStats(filename, section.end - section.begin);
+
+    const unsigned max_threads = maxThreads();
+    const bool parallel = max_threads > 1 && stats.bytes >= parallel_min_bytes;
+    const std::uint64_t chunk_size = parallel ? chooseChunkSize(section, max_threads) : 0;
+    const std::vector<std::uint64_t> boundaries = parallel
+                                                      ? planChunks(section.filename, section.begin, section.end, chunk_size)
+                                                      : std::vector<std::uint64_t>{section.begin, section.end};
+    const std::size_t chunk_count = boundaries.size() - 1;
+
+    std::vector<CSVLintReport> chunk_reports(chunk_count);
+    std::vector<std::size_t> chunk_lines(chunk_count, 0);
+    CSVWorkStealingPool pool(static_cast<unsigned>(std::min<std::size_t>(max_threads, chunk_count)));
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        pool.push([&, chunk] {
+            lintRange(section, boundaries[chunk], boundaries[chunk + 1], max_errors, chunk_reports[chunk], chunk_lines[chunk]);
+        });
+    }
+    pool.run();
+
+    CSVLintReport report;
+    std::size_t line_base = header_row;
+    for (std::size_t chunk = 0; chunk < chunk_count; ++chunk) {
+        report.rows += chunk_reports[chunk].rows;
+        report.error_count += chunk_reports[chunk].error_count;
+        for (CSVLintError &error: chunk_reports[chunk].errors) {
+            if (report.errors.size() == max_errors) {
+                break;
+            }
+            error.line += line_base;
+            report.errors.push_back(std::move(error));
+        }
+        line_base += chunk_lines[chunk];
+    }
+
+    stats.rows = report.rows;
+    stats.chunks = chunk_count;
+    stats.chunk_size = chunk_size;
+    stats.threads = pool.threads();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    report.stats = stats;
+    return report;
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+void CSVParser<TObject, Types...>::lintRange(const DataSection &section, const std::uint64_t begin, const std::uint64_t end,
+                                             const std::size_t max_errors, CSVLintReport &report, std::size_t &lines) const {
+    CSVBlockReader reader;
+    reader.open(section.filename, begin, end);
+
+    std::vector<std::string_view> fields;
+    fields.reserve(header.size());
+    std::vector<std::size_t> invalid;
+    char *line_begin, *line_end;
+    std::uint64_t line_offset = reader.offset();
+
+    auto report_error = [&](const std::uint64_t offset, const std::size_t column, const CSVLintIssue issue, auto &&make_message) {
+        if (report.errors.size() < max_errors) {
+            report.errors.push_back({offset, lines, column, issue, make_message()});
+        }
+        ++report.error_count;
+    };
+
+    for (; reader.nextLine(line_begin, line_end); line_offset = reader.offset()) {
+        ++lines;
+        if (line_begin == line_end) {
+            continue;
+        }
+        ++report.rows;
+
+        if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+            report_error(line_offset, 0, CSVLintIssue::InvalidEncoding, [] {
+                return std::string("Row is not well-formed UTF-8.");
+            });
+            continue;
+        }
+
+        if (const std::size_t quote_at = section.tokenizer.findUnterminatedQuote(line_begin, line_end); quote_at != std::string_view::npos) {
+            report_error(line_offset + quote_at, 0, CSVLintIssue::UnterminatedQuote, [] {
+                return std::string("Quoted field is not terminated.");
+            });
+            continue;
+        }
+
+        section.tokenizer.split(line_begin, line_end, fields);
+        if (fields.size() != header.size()) {
+            report_error(line_offset, 0, CSVLintIssue::ColumnCount, [&] {
+                return std::format("Row has {} fields, the header has {}.", fields.size(), header.size());
+            });
+        }
+
+        invalid.clear();
+        if constexpr (sizeof...(Types) == 1) {
+            for (std::size_t index = 0; index < std::min(fields.size(), header.size()); ++index) {
+                checkField<front_t>(fields, index, invalid);
+            }
+        } else {
+            findInvalidFields(fields, invalid, std::index_sequence_for<Types...>{});
+        }
+        for (const std::size_t index: invalid) {
+            const auto field_offset = static_cast<std::uint64_t>(fields[index].data() - line_begin);
+            report_error(line_offset + field_offset, index, CSVLintIssue::InvalidValue, [&] {
+                return std::format("Value '{}' of column '{}' cannot be converted.", fields[index],
+                                   index < header.size() ? header[index] : std::to_string(index));
+            });
+        }
+    }
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<std::size_t... Index>
+void CSVParser<TObject, Types...>::findInvalidFields(const std::vector<std::string_view> &fields, std::vector<std::size_t> &invalid,
+                                                     std::index_sequence<Index...>) {
+    (checkField<Types>(fields, Index, invalid), ...);
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename TCell>
+void CSVParser<TObject, Types...>::checkField(const std::vector<std::string_view> &fields, const std::size_t index,
+                                              std::vector<std::size_t> &invalid) {
+    // Every text converts to a string: nothing to check (and nothing to allocate).
+    if constexpr (!std::is_same_v<TCell, std::string> && !std::is_same_v<TCell, std::string_view>) {
+        TCell value{};
+        if (index < fields.size() && !fields[index].empty() && !CSVCellParser<TCell>::parse(fields[index], value)) {
+            invalid.push_back(index);
+        }
+    }
+}
+
+
+/* ======= Parse pointer objects from a file ======= */
+
+// Specialization for unordered_map
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename...> class Container, typename K>
+    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, std::shared_ptr<TObject>>>::value)
+Container<K, std::shared_ptr<TObject>> CSVParser<TObject, Types...>::parsePointerObjectsFromFile(const std::string &filename) {
+    Container<K, std::shared_ptr<TObject>> result;
+    parseRows(filename, result, [](Container<K, std::shared_ptr<TObject>> &result, TObject &&newObject) {
+        auto key = newObject.getId();
+        result[key] = std::make_shared<TObject>(std::move(newObject));
+    });
+
+    return result;
+}
+
+// Specialization for other allowed types of containers
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename> class Container>
+    requires AllowedContainer<Container<TObject>>
+Container<std::shared_ptr<TObject>> CSVParser<TObject, Types...>::parsePointerObjectsFromFile(const std::string &filename) {
+    try {
+        // Retrieves data from a row and add the object in the container.
+        Container<std::shared_ptr<TObject>> result;
+
+        parseRows(filename, result, [this](Container<std::shared_ptr<TObject>> &result, TObject &&newObject) {
+            if constexpr (std::is_same_v<Container<TObject>, std::vector<TObject>>) {
+                result.push_back(std::make_shared<TObject>(std::move(newObject)));
+            } else if constexpr (std::is_same_v<Container<TObject>, std::set<TObject>>) {
+                result.emplace(std::make_shared<TObject>(std::move(newObject)));
+            } else if constexpr (std::is_same_v<Container<TObject>, std::unordered_map<int, TObject>>) {
+                result[has_id ? newObject.id : ++objectIdCounter] = std::make_shared<TObject>(newObject);
+            }
+        });
+
+        return result;
+
+    } catch (const WrongHeaderLength&) {
+        throw;
+    } catch (const CSVException &exception) {
+        std::clog << exception.what() << std::endl;
+        return {};
+    } catch (...) {
+        std::clog << "[CSV Parser ERROR] Unexpected exception has occurred." << std::endl;
+        return {};
+    }
+}
+
+
+/* ======= Parse raw objects from a file ======= */
+
+// Specialization for unordered_map
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename...> class Container, typename K>
+    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+Container<K, TObject> CSVParser<TObject, Types...>::parseObjectsFromFile(const std::string &filename) {
+    Container<K, TObject> result;
+    parseRows(filename, result, [](Container<K, TObject> &result, TObject &&newObject) {
+        auto key = newObject.getId();
+        result[key] = std::move(newObject);
+    });
+
+    return result;
+}
+
+// Specialization for other allowed types of containers
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename> class Container>
+    requires AllowedContainer<Container<TObject>>
+Container<TObject> CSVParser<TObject, Types...>::parseObjectsFromFile(const std::string &filename) {
+    try {
+        // Retrieves data from a row and add the object in the container.
+        Container<TObject> result;
+
+        parseRows(filename, result, [this](Container<TObject> &result, TObject &&newObject) {
+            if constexpr (std::is_same_v<Container<TObject>, std::vector<TObject>>) {
+                result.push_back(std::move(newObject));
+            } else if constexpr (std::is_same_v<Container<TObject>, std::set<TObject>>) {
+                result.emplace(std::move(newObject));
+            } else if constexpr (std::is_same_v<Container<TObject>, std::unordered_map<int, TObject>>) {
+                result[has_id ? newObject.id : ++objectIdCounter] = std::make_shared<TObject>(newObject);
+            }
+        });
+
+        return result;
+
+    } catch (const WrongHeaderLength&) {
+        throw;
+    } catch (const CSVException &exception) {
+        std::clog << exception.what() << std::endl;
+        return {};
+    } catch (...) {
+        std::clog << "[CSV Parser ERROR] Unexpected exception has occurred." << std::endl;
+        return {};
+    }
+}
+
+
+/* ======= Resumable parse sessions ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result>
+void CSVParser<TObject, Types...>::insertObject(Result &result, TObject &&object) {
+    using Value = typename Result::value_type;
+
+    if constexpr (is_unordered_map<Result>::value) {
+        auto key = object.getId();
+        if constexpr (std::is_same_v<typename Result::mapped_type, std::shared_ptr<TObject>>) {
+            result[key] = std::make_shared<TObject>(std::move(object));
+        } else {
+            result[key] = std::move(object);
+        }
+    } else if constexpr (std::is_same_v<Value, std::shared_ptr<TObject>>) {
+        if constexpr (std::is_same_v<Result, std::vector<Value>>) {
+            result.push_back(std::make_shared<TObject>(std::move(object)));
+        } else {
+            result.emplace(std::make_shared<TObject>(std::move(object)));
+        }
+    } else if constexpr (std::is_same_v<Result, std::vector<Value>>) {
+        result.push_back(std::move(object));
+    } else {
+        result.emplace(std::move(object));
+    }
+}
+
+// Keeps the whole parse state between steps: the open file, the reader buffer (with any partial row) and the container.
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result>
+class CSVParser<TObject, Types...>::ParseSession {
+public:
+    ParseSession(const CSVParser &parser_, DataSection section_)
+        : parser(&parser_), section(std::move(section_)) {
+        reader.open(section.filename, section.begin, section.end);
+        fields.reserve(parser->header.size());
+        line_number = static_cast<std::size_t>(parser->header_row);
+    }
+
+    // Parses rows until the budget is used up or the file ends. Returns true once the whole file has been parsed.
+    // Throws InvalidEncoding when UTF-8 validation is enabled and a row is invalid.
+    bool step(const CSVBudget budget) {
+        if (finished) {
+            return true;
+        }
+
+        const auto deadline = budget.time == std::chrono::nanoseconds::max()
+                                  ? std::chrono::steady_clock::time_point::max()
+                                  : std::chrono::steady_clock::now() + budget.time;
+        char *line_begin, *line_end;
+
+        for (std::size_t step_rows = 0; step_rows < budget.rows;) {
+            // The clock is only read every 64 lines.
+            if ((line_number & 63) == 0 && std::chrono::steady_clock::now() >= deadline) {
+                return false;
+            }
+            if (!reader.nextLine(line_begin, line_end)) {
+                finished = true;
+                return true;
+            }
+
+            ++line_number;
+            if (line_begin == line_end) {
+                continue;
+            }
+            if (parser->validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+                throw InvalidEncoding(section.filename, line_number);
+            }
+            insertObject(container, parser->parseObjectFromRow(section.tokenizer, line_begin, line_end, fields));
+            ++step_rows;
+            ++row_count;
+
+            if (parser->checkpoint_every && row_count % parser->checkpoint_every == 0) {
+                parser->emitCheckpoint(section, reader.offset(), line_number, row_count);
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool done() const {
+        return finished;
+    }
+
+    // Objects parsed so far.
+    [[nodiscard]] std::size_t rows() const {
+        return row_count;
+    }
+
+    // Fraction of the data section consumed, from 0 to 1.
+    [[nodiscard]] double progress() const {
+        const std::uint64_t total = section.end - section.begin;
+        return total ? static_cast<double>(reader.offset() - section.begin) / static_cast<double>(total) : 1.0;
+    }
+
+    // The container filled so far (complete once done()).
+    [[nodiscard]] Result &result() {
+        return container;
+    }
+
+    [[nodiscard]] Result take() {
+        return std::move(container);
+    }
+
+private:
+    const CSVParser *parser;
+    DataSection section;
+    CSVBlockReader reader;
+    std::vector<std::string_view> fields;
+    Result container;
+    std::size_t line_number = 0, row_count = 0;
+    bool finished = false;
+};
+
+// Specialization for unordered_map
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename...> class Container, typename K>
+    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+typename CSVParser<TObject, Types...>::template ParseSession<Container<K, TObject>> CSVParser<TObject, Types...>::openSession(const std::string &filename) {
+    return ParseSession<Container<K, TObject>>(*this, openDataSection(filename));
+}
+
+// Specialization for other allowed types of containers
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename> class Container>
+    requires AllowedContainer<Container<TObject>>
+typename CSVParser<TObject, Types...>::template ParseSession<Container<TObject>> CSVParser<TObject, Types...>::openSession(const std::string &filename) {
+    return ParseSession<Container<TObject>>(*this, openDataSection(filename));
+}
+
+
+/* ======= Streaming and checkpoint resume ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Sink>
+    requires std::invocable<Sink &, TObject &&>
+void CSVParser<TObject, Types...>::parseObjectsIntoSink(const std::string &filename, Sink &&sink) {
+    const auto start = std::chrono::steady_clock::now();
+    const DataSection section = openDataSection(filename);
+    resetStats(filename, section.end - section.begin);
+
+    // Always on the calling thread: the sink is not required to be thread safe.
+    const RangeResult base{static_cast<std::size_t>(header_row), 0, 0, 0, {}};
+    const RangeResult range = parseRange(section, section.begin, section.end, [&sink](TObject &&object) {
+        sink(std::move(object));
+    }, &base);
+
+    if (range.invalid_line) {
+        throw InvalidEncoding(filename, header_row + range.invalid_line);
+    }
+    stats.rows = range.rows;
+    stats.perf = range.perf;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Target>
+void CSVParser<TObject, Types...>::resumeFromCheckpoint(const CSVCheckpoint &checkpoint, Target &target) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::ifstream file(checkpoint.filename, std::ios::binary);
     if (!file.is_open()) {
-        throw FileOpenException(filename);
+        throw FileOpenException(checkpoint.filename);
     }
+    file.seekg(0, std::ios::end);
+    const auto end = static_cast<std::uint64_t>(file.tellg());
 
-    int current_row(1);
-    std::string row;
-
-    do {
-        std::getline(file, row);
-        current_row++;
-    } while (current_row == header_row);
+    // The checkpoint must point right after a line ending of the same file.
+    char previous = '\n';
+    if (checkpoint.offset > end) {
+        throw InvalidCheckpoint(checkpoint.filename, "offset past the end of the file");
+    }
+    if (checkpoint.offset > 0) {
+        file.seekg(static_cast<std::streamoff>(checkpoint.offset - 1));
+        file.get(previous);
+    }
+    if (previous != '\n') {
+        throw InvalidCheckpoint(checkpoint.filename, "offset is not a record boundary");
+    }
+    file.close();
 
-    // If the delimiter is defined...
-    if (delimiter != '\0') {
-        std::stringstream ss(row);
-        std::string cell;
-        std::vector<std::string> try_header;
+    setHeader(checkpoint.header);
+    custom_header = true;
+    delimiter = checkpoint.delimiter;
+    delimiter_tail = checkpoint.delimiter_tail;
+    quote = checkpoint.quote;
+    escape = checkpoint.escape;
+    header_row = checkpoint.header_row;
 
-        while (std::getline(ss, cell, delimiter)) {
-            try_header.push_back(parseCSVCell<std::string>(ss, cell));
-        }
+    const DataSection section{checkpoint.filename, checkpoint.offset, end, tokenizer()};
+    const RangeResult base{checkpoint.line, checkpoint.rows, 0, 0, {}};
 
-        // If the custom header is not defined, set the default header from CSV file.
-        if (header.empty()) {
-            try {
-                setHeader(try_header);
-                return {false, delimiter};
-            } catch (WrongHeaderLength&) {
-                throw;
-            }
-        }
+    resetStats(checkpoint.filename, end - checkpoint.offset);
 
-        // If the custom header is defined, the new custom header must be of same size.
-        if (try_header.size() == header.size()) {
-            return {true, delimiter};
+    const RangeResult range = parseRange(section, section.begin, section.end, [&target](TObject &&object) {
+        if constexpr (std::invocable<Target &, TObject &&>) {
+            target(std::move(object));
+        } else {
+            insertObject(target, std::move(object));
         }
+    }, &base);
 
-        throw WrongHeaderByDelimiter(filename, try_header.size(), header.size(), header_row, delimiter);
+    if (range.invalid_line) {
+        throw InvalidEncoding(checkpoint.filename, checkpoint.line + range.invalid_line);
     }
+    stats.rows = range.rows;
+    stats.perf = range.perf;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
 
-    // Else, if the delimiter is not defined...
-    std::unordered_map<char, std::pair<int, std::vector<std::string> > > detected_values;
-    for (const char current_delimiter: default_delimiters) {
-        std::stringstream ss(row);
-        std::string cell;
-        std::vector<std::string> try_header;
 
-        while (std::getline(ss, cell, current_delimiter)) {
-            try_header.push_back(parseCSVCell<std::string>(ss, cell));
-        }
+/* ======= Parse raw objects from a batch of files ======= */
 
-        if (try_header.size() == header.size() && !header.empty()) {
-            setHeader(try_header);
-            return {true, current_delimiter};
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result, typename Inserter>
+void CSVParser<TObject, Types...>::parseFiles(const std::vector<std::string> &filenames, std::vector<Result> &results, Inserter &&insert) {
+    const auto start = std::chrono::steady_clock::now();
+
+    struct FileJob {
+        DataSection section;
+        std::string error;
+        std::vector<std::uint64_t> boundaries;
+        std::vector<std::vector<TObject>> chunk_objects;
+        std::vector<RangeResult> chunk_results;
+    };
+
+    const unsigned max_threads = maxThreads();
+    CSVWorkStealingPool pool(max_threads);
+    std::vector<FileJob> jobs(filenames.size());
+
+    // A task failing (a read error, a throwing constructor) fails its file only: the other files are still parsed.
+    std::mutex error_mutex;
+    const auto fail = [&error_mutex](FileJob &job) {
+        std::string message;
+        try {
+            throw;
+        } catch (const std::exception &exception) {
+            message = std::format("[CSV Parser ERROR] Failed to parse '{}'. Reason: {}", job.section.filename, exception.what());
+        } catch (...) {
+            message = std::format("[CSV Parser ERROR] Failed to parse '{}'. Reason: unknown exception", job.section.filename);
+        }
+        std::lock_guard lock(error_mutex);
+        if (job.error.empty()) {
+            job.error = std::move(message);
         }
+    };
 
-        detected_values[current_delimiter] = {try_header.size(), try_header};
-    }
+    stats = {};
+    stats.filename = std::format("{} files", filenames.size());
+    stats.kernel = CSVKernels::active().name;
+    stats.chunks = 0;
 
-    // If no header is defined, all default delimiters will be checked,
-    // and the parser will assume the number of columns in the CSV
-    // matches the number of fields (arity) of the object.
-    if (header.empty()) {
-        // Read next row
-        int length(0);
-        char good_delimiter('\0');
-        std::getline(file, row);
-        std::vector<std::pair<int, char> > detected_values_next_row;
+    for (std::size_t file = 0; file < filenames.size(); ++file) {
+        FileJob &job = jobs[file];
+        try {
+            job.section = openDataSection(filenames[file]);
+        } catch (const WrongHeaderLength&) {
+            throw;
+        } catch (const CSVException &exception) {
+            job.error = exception.what();
+            continue;
+        }
+        stats.bytes += job.section.end - job.section.begin;
 
-        for (const char current_delimiter: default_delimiters) {
-            std::stringstream ss(row);
-            std::string cell;
-            int value_counter(0);
+        // A file task plans its chunks and queues them on its own worker, from where idle workers steal them.
+        pool.push([this, &pool, &job, &fail, max_threads] {
+            try {
+                const DataSection &section = job.section;
+                CSVTrace::Span span(trace, "plan chunks");
+                job.boundaries = section.end - section.begin >= parallel_min_bytes
+                                     ? planChunks(section.filename, section.begin, section.end, chooseChunkSize(section, max_threads))
+                                     : std::vector<std::uint64_t>{section.begin, section.end};
+                job.chunk_objects.resize(job.boundaries.size() - 1);
+                job.chunk_results.resize(job.boundaries.size() - 1);
+            } catch (...) {
+                fail(job);
+                return;
+            }
 
-            while (std::getline(ss, cell, current_delimiter)) {
-                value_counter++;
+            for (std::size_t chunk = 0; chunk + 1 < job.boundaries.size(); ++chunk) {
+                pool.push([this, &job, &fail, chunk] {
+                    try {
+                        job.chunk_results[chunk] = parseRange(job.section, job.boundaries[chunk], job.boundaries[chunk + 1], [&](TObject &&object) {
+                            job.chunk_objects[chunk].push_back(std::move(object));
+                        });
+                    } catch (...) {
+                        fail(job);
+                    }
+                });
             }
+        });
+    }
 
-            if (detected_values[current_delimiter].first == value_counter
-                && value_counter > 0
-                && checkMaxArgs(value_counter)) {
-                good_delimiter = current_delimiter;
-                length = value_counter;
-                break;
+    pool.run();
+
+    for (std::size_t file = 0; file < jobs.size(); ++file) {
+        FileJob &job = jobs[file];
+        std::size_t line_base = header_row;
+        for (const RangeResult &result: job.chunk_results) {
+            if (result.invalid_line && job.error.empty()) {
+                job.error = InvalidEncoding(job.section.filename, line_base + result.invalid_line).what();
             }
+            line_base += result.lines;
+            stats.perf += result.perf;
         }
 
-        if (length) {
-            try {
-                setHeader(detected_values[good_delimiter].second);
-                return {false, good_delimiter};
-            } catch (WrongHeaderLength&) {
-                throw;
+        if (!job.error.empty()) {
+            std::clog << job.error << std::endl;
+            continue;
+        }
+
+        CSVTrace::Span span(trace, "insert");
+        for (auto &objects: job.chunk_objects) {
+            for (auto &object: objects) {
+                insert(results[file], std::move(object));
             }
+            stats.rows += objects.size();
+            std::vector<TObject>().swap(objects);
         }
+        stats.chunks += job.chunk_objects.size();
+        span.setArg("chunks", job.chunk_objects.size());
     }
 
-    throw WrongHeaderByAllDelimiters(filename, detected_values, header.size(), header_row);
+    stats.threads = pool.threads();
+    stats.steals = pool.steals();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
 }
 
-
-/* ======= Parse pointer objects from a file ======= */
-
 // Specialization for unordered_map
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
 template<template<typename...> class Container, typename K>
-    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, std::shared_ptr<TObject>>>::value)
-Container<K, std::shared_ptr<TObject>> CSVParser<TObject, Types...>::parsePointerObjectsFromFile(const std::string &filename) {
-    std::string row;
-    std::ifstream file(filename);
-    initialize(row, file, filename);
-
-    Container<K, std::shared_ptr<TObject>> result;
-    while (std::getline(file, row)) {
-        if (row.empty()) {
-            continue;
-        }
-        TObject newObject = this->parseObjectFromRow(row);
-        result[newObject.getId()] = std::make_shared<TObject>(newObject);
-    }
-
-    return result;
+    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+std::vector<Container<K, TObject>> CSVParser<TObject, Types...>::parseObjectsFromFiles(const std::vector<std::string> &filenames) {
+    std::vector<Container<K, TObject>> results(filenames.size());
+    parseFiles(filenames, results, [](Container<K, TObject> &result, TObject &&newObject) {
+        auto key = newObject.getId();
+        result[key] = std::move(newObject);
+    });
+
+    return results;
 }
 
 // Specialization for other allowed types of containers
@@ -614,63 +6528,179 @@ template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
 template<template<typename> class Container>
     requires AllowedContainer<Container<TObject>>
-Container<std::shared_ptr<TObject>> CSVParser<TObject, Types...>::parsePointerObjectsFromFile(const std::string &filename) {
+std::vector<Container<TObject>> CSVParser<TObject, Types...>::parseObjectsFromFiles(const std::vector<std::string> &filenames) {
     try {
-        std::string row;
-        std::ifstream file(filename);
-        initialize(row, file, filename);
-
-        // Retrieves data from a row and add the object in the container.
-        Container<std::shared_ptr<TObject>> result;
+        std::vector<Container<TObject>> results(filenames.size());
 
-        while (std::getline(file, row)) {
-            if (row.empty()) {
-                continue;
-            }
+        parseFiles(filenames, results, [](Container<TObject> &result, TObject &&newObject) {
             if constexpr (std::is_same_v<Container<TObject>, std::vector<TObject>>) {
-                result.push_back(std::make_shared<TObject>(this->parseObjectFromRow(row)));
+                result.push_back(std::move(newObject));
             } else if constexpr (std::is_same_v<Container<TObject>, std::set<TObject>>) {
-                result.emplace(std::make_shared<TObject>(this->parseObjectFromRow(row)));
-            } else if constexpr (std::is_same_v<Container<TObject>, std::unordered_map<int, TObject>>) {
-                TObject newObject = this->parseObjectFromRow(row);
-                result[has_id ? newObject.id : ++objectIdCounter] = std::make_shared<TObject>(newObject);
+                result.emplace(std::move(newObject));
             }
-        }
+        });
 
-        return result;
+        return results;
 
     } catch (const WrongHeaderLength&) {
         throw;
     } catch (const CSVException &exception) {
         std::clog << exception.what() << std::endl;
-        return {};
+        return std::vector<Container<TObject>>(filenames.size());
     } catch (...) {
         std::clog << "[CSV Parser ERROR] Unexpected exception has occurred." << std::endl;
-        return {};
+        return std::vector<Container<TObject>>(filenames.size());
     }
 }
 
 
-/* ======= Parse raw objects from a file ======= */
+/* ======= Parse raw objects from many small files ======= */
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result>
+std::string CSVParser<TObject, Types...>::parseSmallFile(
+    const std::string &filename, const CSVTokenizer &splitter, CSVBlockReader &reader,
+    std::vector<std::string_view> &fields, Result &result, std::size_t &rows) const {
+    if (!reader.open(filename)) {
+        return FileOpenException(filename).what();
+    }
+
+    char *line_begin, *line_end;
+    for (int line = 1; line <= header_row; ++line) {
+        if (!reader.nextLine(line_begin, line_end)) {
+            return WrongHeaderByDelimiter(filename, 0, header.size(), header_row, splitter.delimiterText()).what();
+        }
+        if (line == header_row) {
+            splitter.split(line_begin, line_end, fields);
+            if (fields.size() != header.size()) {
+                return WrongHeaderByDelimiter(filename, fields.size(), header.size(), header_row, splitter.delimiterText()).what();
+            }
+        }
+    }
+
+    std::size_t line_number = header_row;
+    try {
+        while (reader.nextLine(line_begin, line_end)) {
+            ++line_number;
+            if (line_begin == line_end) {
+                continue;
+            }
+            if (validate_utf8 && !CSVKernels::validateUTF8(line_begin, line_end)) {
+                return InvalidEncoding(filename, line_number).what();
+            }
+            insertObject(result, parseObjectFromRow(splitter, line_begin, line_end, fields));
+            ++rows;
+        }
+    } catch (const std::exception &exception) {
+        return std::format("{} Failed to build an object from row [{}] in file '{}': {}", CSVException::error_mark, line_number, filename, exception.what());
+    }
+    return {};
+}
+
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<typename Result>
+void CSVParser<TObject, Types...>::parseSmallFilesInto(const std::vector<std::string> &filenames, CSVBatchResult<Result> &batch) {
+    const auto start = std::chrono::steady_clock::now();
+    batch.results.resize(filenames.size());
+    batch.errors.resize(filenames.size());
+    resetStats(std::format("{} files", filenames.size()), 0);
+    stats.chunks = filenames.size();
+
+    // The dialect is detected once, on the first readable file, unless the parser already knows it.
+    for (std::size_t file = 0; file < filenames.size() && (delimiter == '\0' || header.empty()); ++file) {
+        try {
+            const std::pair<bool, char> parseType(trust_header(filenames[file]));
+            custom_header = parseType.first;
+            delimiter = parseType.second;
+        } catch (const WrongHeaderLength&) {
+            throw;
+        } catch (const CSVException &exception) {
+            batch.errors[file] = exception.what();
+        }
+    }
+    if (delimiter == '\0' || header.empty()) {
+        batch.failed = filenames.size();
+        return;
+    }
+
+    const CSVTokenizer splitter = tokenizer();
+    CSVWorkStealingPool pool(maxThreads());
+    std::vector<CSVBlockReader> readers;
+    readers.reserve(pool.threads());
+    for (unsigned worker = 0; worker < pool.threads(); ++worker) {
+        readers.emplace_back(small_file_block_size);
+    }
+    std::vector<std::size_t> task_rows((filenames.size() + small_files_per_task - 1) / small_files_per_task, 0);
+
+    for (std::size_t first = 0; first < filenames.size(); first += small_files_per_task) {
+        pool.push([&, first] {
+            CSVBlockReader &reader = readers[CSVWorkStealingPool::currentWorker()];
+            std::vector<std::string_view> fields;
+            fields.reserve(header.size());
+
+            const std::size_t last = std::min(first + small_files_per_task, filenames.size());
+            for (std::size_t file = first; file < last; ++file) {
+                batch.errors[file] = parseSmallFile(filenames[file], splitter, reader, fields, batch.results[file],
+                                                    task_rows[first / small_files_per_task]);
+            }
+        });
+    }
+    pool.run();
+
+    for (std::size_t file = 0; file < filenames.size(); ++file) {
+        batch.failed += !batch.errors[file].empty();
+    }
+    for (const std::size_t rows: task_rows) {
+        stats.rows += rows;
+    }
+    stats.threads = pool.threads();
+    stats.steals = pool.steals();
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
 
 // Specialization for unordered_map
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
 template<template<typename...> class Container, typename K>
     requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
-Container<K, TObject> CSVParser<TObject, Types...>::parseObjectsFromFile(const std::string &filename) {
-    std::string row;
-    std::ifstream file(filename);
-    initialize(row, file, filename);
+CSVBatchResult<Container<K, TObject>> CSVParser<TObject, Types...>::parseSmallFiles(const std::vector<std::string> &filenames) {
+    CSVBatchResult<Container<K, TObject>> batch;
+    parseSmallFilesInto(filenames, batch);
+    return batch;
+}
 
-    Container<K, TObject> result;
-    while (std::getline(file, row)) {
-        if (row.empty()) {
-            continue;
-        }
-        TObject newObject = this->parseObjectFromRow(row);
-        result[newObject.getId()] = newObject;
+// Specialization for other allowed types of containers
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename> class Container>
+    requires AllowedContainer<Container<TObject>>
+CSVBatchResult<Container<TObject>> CSVParser<TObject, Types...>::parseSmallFiles(const std::vector<std::string> &filenames) {
+    CSVBatchResult<Container<TObject>> batch;
+    parseSmallFilesInto(filenames, batch);
+    return batch;
+}
+
+
+/* ======= Parse objects with a string arena ======= */
+
+// Specialization for unordered_map
+template<typename TObject, typename... Types>
+    requires(sizeof...(Types) > 0)
+template<template<typename...> class Container, typename K>
+    requires(HasIdMember<TObject, K> && is_unordered_map<Container<K, TObject>>::value)
+CSVArenaResult<Container<K, TObject>> CSVParser<TObject, Types...>::parseObjectsWithArena(const std::string &filename) {
+    CSVArenaResult<Container<K, TObject>> result;
+    CSVStringArena::Scope arena_scope(&result.strings);
+    arena_target = &result.strings;
+    try {
+        parseRows(filename, result.objects, insertObject<Container<K, TObject>>);
+    } catch (...) {
+        arena_target = nullptr;
+        throw;
     }
+    arena_target = nullptr;
 
     return result;
 }
@@ -680,40 +6710,25 @@ template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
 template<template<typename> class Container>
     requires AllowedContainer<Container<TObject>>
-Container<TObject> CSVParser<TObject, Types...>::parseObjectsFromFile(const std::string &filename) {
+CSVArenaResult<Container<TObject>> CSVParser<TObject, Types...>::parseObjectsWithArena(const std::string &filename) {
+    CSVArenaResult<Container<TObject>> result;
+    CSVStringArena::Scope arena_scope(&result.strings);
+    arena_target = &result.strings;
     try {
-        std::string row;
-        std::ifstream file(filename);
-        initialize(row, file, filename);
-
-        // Retrieves data from a row and add the object in the container.
-        Container<TObject> result;
-
-        while (std::getline(file, row)) {
-            if (row.empty()) {
-                continue;
-            }
-            if constexpr (std::is_same_v<Container<TObject>, std::vector<TObject>>) {
-                result.push_back(this->parseObjectFromRow(row));
-            } else if constexpr (std::is_same_v<Container<TObject>, std::set<TObject>>) {
-                result.emplace(this->parseObjectFromRow(row));
-            } else if constexpr (std::is_same_v<Container<TObject>, std::unordered_map<int, TObject>>) {
-                TObject newObject = this->parseObjectFromRow(row);
-                result[has_id ? newObject.id : ++objectIdCounter] = std::make_shared<TObject>(newObject);
-            }
-        }
-
+        parseRows(filename, result.objects, insertObject<Container<TObject>>);
+        arena_target = nullptr;
         return result;
 
     } catch (const WrongHeaderLength&) {
+        arena_target = nullptr;
         throw;
     } catch (const CSVException &exception) {
         std::clog << exception.what() << std::endl;
-        return {};
     } catch (...) {
         std::clog << "[CSV Parser ERROR] Unexpected exception has occurred." << std::endl;
-        return {};
     }
+    arena_target = nullptr;
+    return {};
 }
 
 
@@ -736,170 +6751,60 @@ TObject constructObjectUniqueTypeArgs(const std::vector<UniqueType> &vec) {
 
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
-template<typename Head>     // Base recursion level
-void CSVParser<TObject, Types...>::parseMultipleTypesObjectFromRow(std::stringstream &ss, const char delimiter, NodeBase *&current) {
-    std::string cell;
-    std::getline(ss, cell, delimiter);
-
-    auto *node = new NodeMT<Head>();
-
-    try {
-        node->single_tuple = std::make_tuple(parseCSVCell<Head>(ss, cell));
-    } catch (...) {
-        node->single_tuple = std::make_tuple(Head{});
-    }
-
-    node->type = typeid(Head).name();
-
-    if (current) {
-        current->next = node;
-        node->prev = current;
-    }
-
-    current = node;
-}
-
-template<typename TObject, typename... Types>
-    requires(sizeof...(Types) > 0)
-template<typename Head, typename... Tail>       // Advancing recursion level
-    requires(sizeof...(Tail) > 0)
-void CSVParser<TObject, Types...>::parseMultipleTypesObjectFromRow(std::stringstream &ss, const char delimiter, NodeBase *&current) {
-    std::string cell;
-    std::getline(ss, cell, delimiter);
-
-    auto *node = new NodeMT<Head>();
-
-    try {
-        node->single_tuple = std::make_tuple(parseCSVCell<Head>(ss, cell));
-    } catch (...) {
-        node->single_tuple = std::make_tuple(Head{});
-    }
-
-    node->type = typeid(Head).name();
-
-    if (current) {
-        current->next = node;
-        node->prev = current;
-    }
-
-    current = node;
-
-    if (sizeof...(Tail) > 0) {
-        parseMultipleTypesObjectFromRow<Tail...>(ss, delimiter, current);
-    }
+template<std::size_t... Index>
+std::tuple<Types...> CSVParser<TObject, Types...>::buildTupleFromFields(const std::vector<std::string_view> &fields, std::index_sequence<Index...>) {
+    // Braced initialization keeps the left-to-right column order.
+    return std::tuple<Types...>{parseCSVCell<Types>(fields, Index)...};
 }
 
 
-/* ======= Tuple builder (from dynamic double linked array) ======= */
+/* ======= CSV cell parsing (quotation handled by the tokenizer) ======= */
 
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
-template<typename T>
-T CSVParser<TObject, Types...>::extractAndAdvance(NodeBase *&node) {
-    auto *typed = dynamic_cast<NodeMT<T> *>(node);
-    if (!typed) {
-        throw std::runtime_error("Type mismatch during object construction.");
+template<typename TCell>
+TCell CSVParser<TObject, Types...>::parseCSVCell(const std::vector<std::string_view> &fields, const std::size_t index) {
+    TCell value{};
+    if (index < fields.size() && !fields[index].empty() && !CSVCellParser<TCell>::parse(fields[index], value)) {
+        return TCell{};
     }
-    T val = std::get<0>(typed->single_tuple);
-    node = node->prev;
-    return val;
-}
-
-
-template<typename TObject, typename... Types>
-    requires(sizeof...(Types) > 0)
-template<typename... NodeTypes>
-std::tuple<NodeTypes...> CSVParser<TObject, Types...>::buildTupleFromNodes(NodeBase *&node) {
-    return std::make_tuple(extractAndAdvance<Types>(node)...);
+    return value;
 }
 
 
-/* ======= CSV cell parsing (quotation sensible) ======= */
+/* ======= Parsing method selection ======= */
 
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
-template <typename TCell>
-TCell CSVParser<TObject, Types...>::parseCSVCell(std::stringstream& ss, std::string cell) {
-    if (cell.empty()) {
-        return TCell{};
-    }
-
-    if constexpr (std::is_same_v<TCell, std::string>) {
-        if (cell.front() == quote) {
-            std::string temp;
-            cell.erase(0, 1);
-
-            if (!cell.empty() && cell.back() == quote) {
-                cell.pop_back();
-                return cell;
-            }
-
-            while (std::getline(ss, temp, delimiter)) {
-                cell += delimiter + temp;
-                if (!cell.empty() && cell.back() == quote) {
-                    cell.pop_back();
-                    break;
-                }
-
-                if (!std::getline(ss, temp, delimiter)) {
-                    throw std::runtime_error("Unterminated quoted field");
-                }
-            }
-        }
-        return cell;
-    }
-
-    std::istringstream iss(cell);
-    TCell value;
-    iss >> value;
-
-    if (iss.fail()) {
-        throw std::runtime_error("Failed to parse the cell");
-    }
-
-    return value;
+TObject CSVParser<TObject, Types...>::parseObjectFromRow(
+    const CSVTokenizer &splitter, char *begin, char *end, std::vector<std::string_view> &fields) const {
+    splitter.split(begin, end, fields);
+    return objectFromFields(fields);
 }
 
-
-/* ======= Parsing method selection ======= */
-
 template<typename TObject, typename... Types>
     requires(sizeof...(Types) > 0)
-TObject CSVParser<TObject, Types...>::parseObjectFromRow(const std::string &row) {
+TObject CSVParser<TObject, Types...>::objectFromFields(const std::vector<std::string_view> &fields,
+                                                      const std::size_t columns) const {
     if constexpr (sizeof...(Types) == 1) {
-        std::vector<front_t> temp_values;
-        std::stringstream ss(row);
-        std::string cell;
-        int current_cell_count(0);
-
-        while (std::getline(ss, cell, delimiter) && current_cell_count++ < header.size()) {
-            try {
-                temp_values.push_back(parseCSVCell<front_t>(ss, cell));
-            } catch (std::exception &) {
-                temp_values.push_back(front_t(0));
-            }
-        }
-
+        const std::size_t cell_count = std::min(fields.size(), columns);
         if constexpr (std::is_same_v<TObject, std::vector<front_t>>) {
-            return temp_values;
+            std::vector<front_t> values;
+            values.reserve(cell_count);
+            for (std::size_t index = 0; index < cell_count; ++index) {
+                values.push_back(parseCSVCell<front_t>(fields, index));
+            }
+            return values;
         } else {
+            // The values only feed the constructor: one buffer per thread is reused for every row.
+            thread_local std::vector<front_t> temp_values;
+            temp_values.clear();
+            for (std::size_t index = 0; index < cell_count; ++index) {
+                temp_values.push_back(parseCSVCell<front_t>(fields, index));
+            }
             return constructObjectUniqueTypeArgs<TObject, front_t, max_args_unique_type>(temp_values);
         }
     } else {
-        std::stringstream ss(row);
-        NodeBase *current = nullptr;
-        parseMultipleTypesObjectFromRow<Types...>(ss, delimiter, current);
-
-        NodeBase *node = current;
-
-        auto tuple = buildTupleFromNodes<Types...>(node);
-
-        while (node) {
-            NodeBase *prev = node->prev;
-            delete prev;
-            node = prev;
-        }
-
-        return std::make_from_tuple<TObject>(tuple);
+        return std::make_from_tuple<TObject>(buildTupleFromFields(fields, std::index_sequence_for<Types...>{}));
     }
-}
\ No newline at end of file
+}
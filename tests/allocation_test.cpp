@@ -0,0 +1,140 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Counts every allocation of the process, to check that the row loop allocates nothing per row: parsing 10 times
+// more rows into a sink must not allocate more. Both files span several read blocks, so the reader's buffer has
+// reached its final size in each of them.
+static std::atomic<std::size_t> allocations{0};
+
+// Both operator new overloads allocate here, and every operator delete frees with std::free: the pairs match.
+static void *allocate(const std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(const std::size_t size) {
+    return allocate(size);
+}
+
+void *operator new[](const std::size_t size) {
+    return allocate(size);
+}
+
+// Once allocate() is inlined (e.g. with LTO), GCC takes std::free for a mismatch with operator new: both sides use
+// malloc/free.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+struct Record {
+    int id = 0;
+    std::string text;   // Short enough for the small-string buffer.
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+struct Point {
+    double x = 0, y = 0, z = 0;
+
+    Point() = default;
+    Point(const double x_, const double y_, const double z_) : x(x_), y(y_), z(z_) {
+    }
+};
+
+// Allocations made while streaming 'path' into a sink that keeps nothing.
+template<typename Parser>
+std::size_t sinkAllocations(Parser &parser, const std::string &path, std::size_t &rows) {
+    rows = 0;
+    const std::size_t before = allocations.load();
+    parser.parseObjectsIntoSink(path, [&rows](auto &&) { ++rows; });
+    return allocations.load() - before;
+}
+
+int main() {
+    std::size_t rows = 0;
+
+    // Multiple types: int, std::string, double.
+    {
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        corpus::typicalRows("allocation_small.csv", 100000);
+        corpus::typicalRows("allocation_large.csv", 1000000);
+        sinkAllocations(parser, "allocation_small.csv", rows);    // Warm-up (thread-local buffers, kernel table).
+        const std::size_t small = sinkAllocations(parser, "allocation_small.csv", rows);
+        CHECK(rows == 100000);
+        const std::size_t large = sinkAllocations(parser, "allocation_large.csv", rows);
+        CHECK(rows == 1000000);
+        std::cout << std::format("multiple types: {} allocations for 100000 rows, {} for 1000000 rows", small, large) << std::endl;
+        CHECK(large == small);
+    }
+
+    // One type for every column: the constructor arguments go through a reused buffer.
+    {
+        std::string content = "x,y,z\n";
+        for (int row = 0; row < 1000000; ++row) {
+            content += std::format("{},{}.5,-{}\n", row, row % 100, row % 7);
+        }
+        writeFile("allocation_points_large.csv", content);
+        writeFile("allocation_points_small.csv", content.substr(0, content.find('\n', content.size() / 10) + 1));
+
+        CSVParser<Point, double> parser;
+        parser.setVerbose(false);
+        sinkAllocations(parser, "allocation_points_small.csv", rows);
+        const std::size_t small = sinkAllocations(parser, "allocation_points_small.csv", rows);
+        const std::size_t large = sinkAllocations(parser, "allocation_points_large.csv", rows);
+        CHECK(rows == 1000000);
+        std::cout << std::format("unique type: {} allocations for 1/10 of the rows, {} for all", small, large) << std::endl;
+        CHECK(large == small);
+    }
+
+    // Materializing rows of a block already decompressed, once the row buffer fits the longest of them.
+    {
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        const CSVCompressedRows store = parser.compressRows("allocation_small.csv");
+        auto cursor = store.cursor();
+        for (std::size_t row = 0; row < 100; ++row) {
+            parser.materialize(cursor, row);
+        }
+        const std::size_t before = allocations.load();
+        for (std::size_t row = 0; row < 100; ++row) {
+            const Record record = parser.materialize(cursor, row);
+            CHECK(record.id == static_cast<int>(row));
+        }
+        CHECK(allocations.load() == before);
+    }
+
+    return check_failures ? 1 : 0;
+}
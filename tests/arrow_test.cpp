@@ -0,0 +1,128 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <cstring>
+
+// Arrow export: the struct layout and column formats, validity bitmaps and null counts for missing or unconvertible
+// cells, the values and text offsets of a larger file, and the release callbacks.
+using Price = CSVDecimal<9, 2>;
+
+struct Item {
+    int id = 0;
+    Price price;
+    bool active = false;
+    std::string name;
+    double ratio = 0;
+    std::uint8_t small = 0;
+
+    Item() = default;
+    Item(const int id_, const Price price_, const bool active_, std::string name_, const double ratio_, const std::uint8_t small_)
+        : id(id_), price(price_), active(active_), name(std::move(name_)), ratio(ratio_), small(small_) {
+    }
+};
+
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+bool valid(const ArrowArray *column, const std::size_t row) {
+    return static_cast<const std::uint8_t *>(column->buffers[0])[row / 8] >> (row % 8) & 1;
+}
+
+template<typename T>
+T value(const ArrowArray *column, const std::size_t row) {
+    T result;
+    std::memcpy(&result, static_cast<const std::byte *>(column->buffers[1]) + row * sizeof(T), sizeof(T));
+    return result;
+}
+
+std::string_view text(const ArrowArray *column, const std::size_t row) {
+    const auto *offsets = static_cast<const std::int32_t *>(column->buffers[1]);
+    return {static_cast<const char *>(column->buffers[2]) + offsets[row], static_cast<std::size_t>(offsets[row + 1] - offsets[row])};
+}
+
+bool aligned(const ArrowArray *column) {
+    for (std::int64_t buffer = 0; buffer < column->n_buffers; ++buffer) {
+        if (reinterpret_cast<std::uintptr_t>(column->buffers[buffer]) % 64) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    writeFile("arrow.csv", "id,price,active,name,ratio,small\n"
+                           "1,12.50,true,\"Smith, J\",0.5,7\n"
+                           "2,,no,,1.25,300\n"
+                           "\n"
+                           "3,abc,yes,x,oops,255\n"
+                           "4,-1.005\n");
+    {
+        CSVParser<Item, int, Price, bool, std::string, double, std::uint8_t> parser;
+        parser.setVerbose(false);
+        ArrowArray array{};
+        ArrowSchema schema{};
+        parser.parseIntoArrow("arrow.csv", &array, &schema);
+
+        CHECK(std::string_view(schema.format) == "+s" && schema.n_children == 6);
+        CHECK(array.length == 4 && array.null_count == 0 && array.n_children == 6 && array.n_buffers == 1);
+        const std::vector<std::string_view> formats = {"i", "d:9,2", "b", "u", "g", "C"};
+        const std::vector<std::string_view> names = {"id", "price", "active", "name", "ratio", "small"};
+        const std::vector<std::int64_t> null_counts = {0, 2, 1, 1, 2, 2};
+        for (std::size_t column = 0; column < 6; ++column) {
+            CHECK(schema.children[column]->format == formats[column]);
+            CHECK(schema.children[column]->name == names[column]);
+            CHECK(schema.children[column]->flags == ARROW_FLAG_NULLABLE);
+            CHECK(array.children[column]->length == 4 && array.children[column]->null_count == null_counts[column]);
+            CHECK(aligned(array.children[column]));
+        }
+
+        const ArrowArray *const *columns = array.children;
+        CHECK(value<int>(columns[0], 0) == 1 && value<int>(columns[0], 3) == 4);
+        // decimal128: two 64-bit words per row, the high one sign-extended.
+        CHECK(value<std::int64_t>(columns[1], 0) == 1250 && value<std::int64_t>(columns[1], 1) == 0 && valid(columns[1], 0));
+        CHECK(!valid(columns[1], 1) && !valid(columns[1], 2));
+        CHECK(value<std::int64_t>(columns[1], 6) == -101 && value<std::int64_t>(columns[1], 7) == -1);
+        const auto active = static_cast<const std::uint8_t *>(columns[2]->buffers[1])[0];
+        CHECK((active & 0b0111) == 0b0101 && !valid(columns[2], 3));
+        CHECK(text(columns[3], 0) == "Smith, J" && text(columns[3], 1).empty() && valid(columns[3], 1));
+        CHECK(text(columns[3], 2) == "x" && !valid(columns[3], 3));
+        CHECK(value<double>(columns[4], 1) == 1.25 && !valid(columns[4], 2) && !valid(columns[4], 3));
+        CHECK(value<std::uint8_t>(columns[5], 0) == 7 && !valid(columns[5], 1) && value<std::uint8_t>(columns[5], 2) == 255);
+
+        array.release(&array);
+        schema.release(&schema);
+        CHECK(array.release == nullptr && schema.release == nullptr);
+    }
+
+    // A larger file: every value and text cell matches the objects of a regular parse.
+    {
+        corpus::typicalRows("arrow_typical.csv", 100000);
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        const auto records = parser.parseObjectsFromFile<std::vector>("arrow_typical.csv");
+        ArrowArray array{};
+        ArrowSchema schema{};
+        parser.parseIntoArrow("arrow_typical.csv", &array, &schema);
+        CHECK(array.length == 100000 && parser.getStats().rows == 100000);
+
+        bool equal = records.size() == 100000;
+        for (std::size_t row = 0; equal && row < records.size(); ++row) {
+            equal = value<int>(array.children[0], row) == records[row].id && text(array.children[1], row) == records[row].text &&
+                    value<double>(array.children[2], row) == records[row].value;
+        }
+        CHECK(equal);
+        CHECK(array.children[0]->null_count == 0 && array.children[1]->null_count == 0 && array.children[2]->null_count == 0);
+        array.release(&array);
+        schema.release(&schema);
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,119 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <random>
+#include <sstream>
+#include <unordered_map>
+
+// UUID and IP address columns: accepted and rejected spellings, canonical text, IPv4-mapped storage, ordering and
+// hashing, and keyed containers of a parsed file.
+struct Session {
+    CSVUUID id;
+    CSVIPAddress client;
+    int port = 0;
+
+    Session() = default;
+    Session(const CSVUUID id_, const CSVIPAddress client_, const int port_) : id(id_), client(client_), port(port_) {
+    }
+
+    [[nodiscard]] CSVUUID getId() const {
+        return id;
+    }
+};
+
+CSVUUID uuid(const std::string_view text) {
+    CSVUUID value;
+    CHECK(CSVUUID::parse(text, value));
+    return value;
+}
+
+CSVIPAddress address(const std::string_view text) {
+    CSVIPAddress value;
+    CHECK(CSVIPAddress::parse(text, value));
+    return value;
+}
+
+int main() {
+    const CSVUUID first = uuid("123e4567-e89b-12d3-a456-426614174000");
+    CHECK(first.bytes()[0] == 0x12 && first.bytes()[15] == 0x00 && first.toString() == "123e4567-e89b-12d3-a456-426614174000");
+    CHECK(uuid("123E4567-E89B-12D3-A456-426614174000") == first);
+    CHECK(uuid("{123e4567-e89b-12d3-a456-426614174000}") == first);
+    CHECK(uuid("123e4567e89b12d3a456426614174000") == first);
+    CHECK(uuid("00000000-0000-0000-0000-000000000001") < uuid("10000000-0000-0000-0000-000000000000"));
+    CSVUUID rejected;
+    for (const std::string_view invalid: {"", "123e4567-e89b-12d3-a456-42661417400", "123e4567-e89b-12d3-a456-4266141740000",
+                                          "123e4567-e89b-12d3-a456_426614174000", "123e4567-e89b-12d3-a456-42661417400g",
+                                          "{123e4567-e89b-12d3-a456-426614174000", "123e4567e89b12d3a45642661417400"}) {
+        CHECK(!CSVUUID::parse(invalid, rejected));
+    }
+
+    // Random UUIDs survive their text form, compare like it and rarely share a hash.
+    std::mt19937_64 random(7);
+    std::vector<CSVUUID> uuids;
+    std::unordered_map<std::size_t, int> hashes;
+    bool round_trip = true, ordered = true;
+    for (int index = 0; index < 2000; ++index) {
+        std::array<std::uint8_t, 16> bytes{};
+        for (std::uint8_t &byte: bytes) {
+            byte = static_cast<std::uint8_t>(random());
+        }
+        const CSVUUID value = CSVUUID::fromBytes(bytes);
+        std::ostringstream stream;
+        stream << value;
+        CSVUUID parsed;
+        round_trip = round_trip && stream.str() == value.toString() && CSVUUID::parse(stream.str(), parsed) && parsed == value;
+        if (!uuids.empty()) {
+            ordered = ordered && (uuids.back() < value) == (uuids.back().toString() < value.toString());
+        }
+        uuids.push_back(value);
+        ++hashes[std::hash<CSVUUID>{}(value)];
+    }
+    CHECK(round_trip && ordered && hashes.size() == uuids.size());
+
+    const CSVIPAddress localhost = address("127.0.0.1");
+    CHECK(localhost.isV4() && localhost.v4() == 0x7F000001 && localhost == CSVIPAddress::fromV4(0x7F000001));
+    CHECK(localhost == address("::ffff:127.0.0.1") && localhost == address("::FFFF:7f00:1"));
+    CHECK(localhost.toString() == "127.0.0.1" && address("255.255.255.255").v4() == 0xFFFFFFFF);
+    CHECK(address("0.0.0.0") < address("0.0.0.1") && address("9.0.0.0") < address("10.0.0.0"));
+    CHECK(!address("::1").isV4() && address("::1").bytes()[15] == 1);
+
+    // RFC 5952 text: lower case, no leading zeros, the first longest run of zero groups compressed, single zeros kept.
+    const std::vector<std::pair<std::string_view, std::string_view>> canonical = {
+        {"::", "::"},
+        {"::1", "::1"},
+        {"2001:0DB8:0000:0000:0001:0000:0000:0001", "2001:db8::1:0:0:1"},
+        {"2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"},
+        {"2001:db8:0:0:1::1", "2001:db8::1:0:0:1"},
+        {"1:2:3:4:5:6:7::", "1:2:3:4:5:6:7:0"},
+        {"fe80::1:2:3.4.5.6", "fe80::1:2:304:506"},
+        {"1:0:0:2:0:0:0:3", "1:0:0:2::3"},
+    };
+    for (const auto &[text, expected]: canonical) {
+        CHECK(address(text).toString() == expected);
+        CHECK(address(expected) == address(text));
+    }
+
+    CSVIPAddress invalid_address;
+    for (const std::string_view invalid: {"", "1.2.3", "1.2.3.4.5", "256.1.1.1", "01.2.3.4", "1.2.3.4 ", "1..2.3", "1:2::3::4",
+                                          ":1", "1:", "1:2:3:4:5:6:7:8:9", "1:2:3:4:5:6:7:8::", "12345::", "fe80::1%eth0",
+                                          "::g", "1.2.3.4::", "::1.2.3.4:5"}) {
+        CHECK(!CSVIPAddress::parse(invalid, invalid_address));
+    }
+
+    // Columns of a file, keyed by UUID; cells are trimmed, invalid ones are reported by lintFile().
+    writeFile("binary_key.csv", "id,client,port\n"
+                                "123e4567-e89b-12d3-a456-426614174000,10.0.0.1,443\n"
+                                " {00000000-0000-0000-0000-0000000000ff} , 2001:db8::1 ,80\n"
+                                "00000000-0000-0000-0000-000000000002,10.0.0.256,22\n");
+    CSVParser<Session, CSVUUID, CSVIPAddress, int> parser;
+    parser.setVerbose(false);
+    const auto sessions = parser.parseObjectsFromFile<std::unordered_map, CSVUUID>("binary_key.csv");
+    CHECK(sessions.size() == 3);
+    CHECK(sessions.contains(first) && sessions.at(first).client == CSVIPAddress::fromV4(0x0A000001));
+    const auto second = sessions.find(uuid("00000000-0000-0000-0000-0000000000ff"));
+    CHECK(second != sessions.end() && second->second.client == address("2001:db8::1") && second->second.port == 80);
+    const CSVLintReport report = parser.lintFile("binary_key.csv");
+    CHECK(report.error_count == 1 && report.errors.size() == 1 && report.errors[0].line == 4 && report.errors[0].column == 1);
+
+    return check_failures ? 1 : 0;
+}
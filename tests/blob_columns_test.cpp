@@ -0,0 +1,117 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <random>
+
+// Blob columns through the parser at every kernel level: random payloads of every length up to a few vector widths,
+// hex in both cases and base64 with and without padding, decoded into owned buffers shared by copies, then exported
+// to Arrow as binary.
+using Hex = CSVBlob<CSVBlobEncoding::Hex>;
+using Base64 = CSVBlob<CSVBlobEncoding::Base64>;
+
+struct Packet {
+    int id = 0;
+    Hex digest;
+    Base64 payload;
+
+    Packet() = default;
+    Packet(const int id_, Hex digest_, Base64 payload_) : id(id_), digest(std::move(digest_)), payload(std::move(payload_)) {
+    }
+};
+
+std::string encodeHex(const std::string &bytes, const bool upper) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    std::string text;
+    for (const char byte: bytes) {
+        text.push_back(digits[static_cast<unsigned char>(byte) >> 4]);
+        text.push_back(digits[static_cast<unsigned char>(byte) & 15]);
+    }
+    return text;
+}
+
+std::string encodeBase64(const std::string &bytes, const bool padded) {
+    const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string text;
+    for (std::size_t index = 0; index < bytes.size(); index += 3) {
+        const std::size_t count = std::min<std::size_t>(3, bytes.size() - index);
+        std::uint32_t group = 0;
+        for (std::size_t byte = 0; byte < 3; ++byte) {
+            group = group << 8 | (byte < count ? static_cast<unsigned char>(bytes[index + byte]) : 0u);
+        }
+        for (std::size_t digit = 0; digit < 4; ++digit) {
+            if (digit <= count) {
+                text.push_back(alphabet[group >> (18 - 6 * digit) & 63]);
+            } else if (padded) {
+                text.push_back('=');
+            }
+        }
+    }
+    return text;
+}
+
+bool sameBytes(const std::span<const std::uint8_t> bytes, const std::string &expected) {
+    return std::string_view(reinterpret_cast<const char *>(bytes.data()), bytes.size()) == expected;
+}
+
+int main() {
+    std::mt19937 random(120);
+    std::vector<std::string> payloads;
+    std::string file = "id,digest,payload\n";
+    for (std::size_t length = 0; length < 200; ++length) {
+        std::string bytes(length, '\0');
+        for (char &byte: bytes) {
+            byte = static_cast<char>(random());
+        }
+        file += std::to_string(length) + "," + encodeHex(bytes, length % 2) + "," + encodeBase64(bytes, length % 3) + "\n";
+        payloads.push_back(std::move(bytes));
+    }
+    file += "200,0g,Zg=\n";
+    writeFile("blob_columns.csv", file);
+
+    for (const CSVKernelLevel level: {CSVKernelLevel::Scalar, CSVKernelLevel::SSE42, CSVKernelLevel::AVX2, CSVKernelLevel::AVX512}) {
+        if (level > CSVKernels::detect()) {
+            continue;
+        }
+        CSVKernels::force(level);
+        CSVParser<Packet, int, Hex, Base64> parser;
+        parser.setVerbose(false);
+        const auto packets = parser.parseObjectsFromFile<std::vector>("blob_columns.csv");
+        CHECK(packets.size() == payloads.size() + 1);
+        bool equal = packets.size() == payloads.size() + 1;
+        for (std::size_t row = 0; equal && row < payloads.size(); ++row) {
+            equal = sameBytes(packets[row].digest.bytes(), payloads[row]) && sameBytes(packets[row].payload.bytes(), payloads[row]);
+        }
+        std::cout << std::format("{}: {} blobs compared", CSVKernels::active().name, 2 * payloads.size()) << std::endl;
+        CHECK(equal);
+        if (equal) {
+            // Unconvertible cells are empty; copies share the decoded bytes.
+            CHECK(packets.back().digest.empty() && packets.back().payload.empty());
+            const Packet copy = packets[150];
+            CHECK(copy.payload.data() == packets[150].payload.data() && copy.digest == packets[150].digest);
+        }
+    }
+    CSVKernels::reset();
+
+    // Arrow binary columns hold the decoded bytes; empty (row 0) and unconvertible cells are nulls.
+    CSVParser<Packet, int, Hex, Base64> parser;
+    parser.setVerbose(false);
+    ArrowArray array{};
+    ArrowSchema schema{};
+    parser.parseIntoArrow("blob_columns.csv", &array, &schema);
+    CHECK(array.length == 201 && std::string_view(schema.children[1]->format) == "z" && std::string_view(schema.children[2]->format) == "z");
+    bool exported = true;
+    for (std::size_t column = 1; column <= 2; ++column) {
+        const ArrowArray *blobs = array.children[column];
+        const auto *offsets = static_cast<const std::int32_t *>(blobs->buffers[1]);
+        const auto *data = static_cast<const std::uint8_t *>(blobs->buffers[2]);
+        exported = exported && blobs->null_count == 2 && offsets[201] == offsets[200];
+        for (std::size_t row = 0; exported && row < payloads.size(); ++row) {
+            exported = sameBytes({data + offsets[row], static_cast<std::size_t>(offsets[row + 1] - offsets[row])}, payloads[row]);
+        }
+    }
+    CHECK(exported);
+    array.release(&array);
+    schema.release(&schema);
+
+    return check_failures ? 1 : 0;
+}
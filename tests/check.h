@@ -0,0 +1,38 @@
+#ifndef CSV_PARSER_TESTS_CHECK_H
+#define CSV_PARSER_TESTS_CHECK_H
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+// Minimal assertions: a failed CHECK is printed and makes the test return 1, the remaining checks still run.
+inline int check_failures = 0;
+
+#define CHECK(condition)                                                                                     \
+    do {                                                                                                     \
+        if (!(condition)) {                                                                                  \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl;       \
+            ++check_failures;                                                                                \
+        }                                                                                                    \
+    } while (false)
+
+// True if 'function' throws an Exception (any other exception, or none, is false).
+template<typename Exception, typename Function>
+bool throws(Function &&function) {
+    try {
+        function();
+    } catch (const Exception &) {
+        return true;
+    } catch (...) {
+    }
+    return false;
+}
+
+// Writes 'content' to 'path' (relative to the test's working directory) and returns the path.
+inline std::string writeFile(const std::string &path, const std::string &content) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << content;
+    return path;
+}
+
+#endif
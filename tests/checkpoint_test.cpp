@@ -0,0 +1,93 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <stdexcept>
+
+// A parse interrupted after a checkpoint and resumed from the saved checkpoint gives the objects of one uninterrupted
+// parse. Checkpoint files keep every value on its own line, whatever characters the header cells contain.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+// Parses 'path' with 'header' until the checkpoint after 'stop' rows is saved, then resumes from the checkpoint file.
+std::vector<Record> interruptAndResume(const std::string &path, const std::size_t every, const std::size_t stop,
+                                       const std::vector<std::string> &header) {
+    std::vector<Record> records;
+    Parser interrupted(header);
+    interrupted.setVerbose(false);
+    // Delimiter detection would replace the custom header with the file's.
+    interrupted.setDelimiter(',');
+    interrupted.setCheckpoint(every, [stop](const CSVCheckpoint &checkpoint) {
+        checkpoint.save("checkpoint.txt");
+        if (checkpoint.rows == stop) {
+            throw std::runtime_error("interrupted");
+        }
+    });
+    CHECK(throws<std::runtime_error>([&] {
+        interrupted.parseObjectsIntoSink(path, [&records](Record &&record) { records.push_back(std::move(record)); });
+    }));
+
+    const CSVCheckpoint checkpoint = CSVCheckpoint::load("checkpoint.txt");
+    CHECK(checkpoint.rows == stop);
+    records.resize(checkpoint.rows);
+    Parser resumed;
+    resumed.resumeFromCheckpoint(checkpoint, records);
+    return records;
+}
+
+int main() {
+    corpus::typicalRows("checkpoint.csv", 200000);
+    Parser parser;
+    parser.setVerbose(false);
+    const std::vector<Record> expected = parser.parseObjectsFromFile<std::vector>("checkpoint.csv");
+    CHECK(interruptAndResume("checkpoint.csv", 10000, 70000, {"id", "text", "value"}) == expected);
+
+    // Header cells with line breaks, backslashes and '=' survive the checkpoint file.
+    const std::vector<std::string> header = {"first\nid", "te\\xt\r\n", "value=\\n"};
+    writeFile("checkpoint_header.csv", "id,text,value\n1,a,1.5\n2,b,2.5\n3,c,3.5\n4,d,4.5\n");
+    const std::vector<Record> small = parser.parseObjectsFromFile<std::vector>("checkpoint_header.csv");
+    CHECK(small.size() == 4);
+    CHECK(interruptAndResume("checkpoint_header.csv", 2, 2, header) == small);
+    const CSVCheckpoint loaded = CSVCheckpoint::load("checkpoint.txt");
+    CHECK(loaded.header == header);
+    CHECK(loaded.line == 3 && loaded.rows == 2);
+
+    CSVCheckpoint checkpoint;
+    checkpoint.filename = "checkpoint\nname.csv";
+    checkpoint.header = {"\\", "\r", "", "\n\n"};
+    checkpoint.save("checkpoint.txt");
+    const CSVCheckpoint copy = CSVCheckpoint::load("checkpoint.txt");
+    CHECK(copy.filename == checkpoint.filename && copy.header == checkpoint.header);
+
+    // Version 2 checkpoints wrote text verbatim and still load as written.
+    writeFile("checkpoint_v2.txt", "csv-checkpoint 2\nfilename=C:\\data\\in.csv\noffset=0\nline=1\nrows=0\ndelimiter=44\n"
+                                   "quote=34\nheader_row=1\ndelimiter_tail=\nescape=0\nheader=1\na\\nb\n");
+    const CSVCheckpoint old = CSVCheckpoint::load("checkpoint_v2.txt");
+    CHECK(old.filename == "C:\\data\\in.csv" && old.header == std::vector<std::string>{"a\\nb"});
+
+    // Unknown or incomplete escape sequences, unknown versions and offsets inside a record are rejected.
+    writeFile("checkpoint_bad.txt", "csv-checkpoint 3\nfilename=in.csv\noffset=0\nline=1\nrows=0\ndelimiter=44\n"
+                                    "quote=34\nheader_row=1\ndelimiter_tail=\nescape=0\nheader=1\na\\tb\n");
+    CHECK(throws<InvalidCheckpoint>([] { CSVCheckpoint::load("checkpoint_bad.txt"); }));
+    writeFile("checkpoint_bad.txt", "csv-checkpoint 3\nfilename=in.csv\\\n");
+    CHECK(throws<InvalidCheckpoint>([] { CSVCheckpoint::load("checkpoint_bad.txt"); }));
+    writeFile("checkpoint_bad.txt", "csv-checkpoint 4\n");
+    CHECK(throws<InvalidCheckpoint>([] { CSVCheckpoint::load("checkpoint_bad.txt"); }));
+    CSVCheckpoint inside = loaded;
+    inside.offset += 1;
+    std::vector<Record> ignored;
+    CHECK(throws<InvalidCheckpoint>([&] { Parser().resumeFromCheckpoint(inside, ignored); }));
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,99 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <sstream>
+
+// CRC32C and XXH64 against published test vectors, the CRC32C combination of two parts against one pass, and the
+// checksum of a file parsed in parallel chunks against the checksum of its bytes.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+std::uint32_t crc32c(const std::string &bytes) {
+    return CSVKernels::crc32c(0, bytes.data(), bytes.data() + bytes.size());
+}
+
+std::uint64_t xxh64(const std::string &bytes) {
+    CSVXXH64 hash;
+    hash.update(bytes.data(), bytes.data() + bytes.size());
+    return hash.digest();
+}
+
+int main() {
+    // CRC32C check value and the iSCSI vectors of RFC 3720 (B.4), with every kernel level the CPU supports.
+    std::string ascending(32, '\0'), descending(32, '\0');
+    for (int index = 0; index < 32; ++index) {
+        ascending[index] = static_cast<char>(index);
+        descending[index] = static_cast<char>(31 - index);
+    }
+    for (const CSVKernelLevel level: {CSVKernelLevel::Scalar, CSVKernelLevel::SSE42}) {
+        CSVKernels::force(std::min(level, CSVKernels::detect()));
+        CHECK(crc32c("") == 0);
+        CHECK(crc32c("123456789") == 0xE3069283u);
+        CHECK(crc32c(std::string(32, '\0')) == 0x8A9136AAu);
+        CHECK(crc32c(std::string(32, '\xFF')) == 0x62A8AB43u);
+        CHECK(crc32c(ascending) == 0x46DD794Eu);
+        CHECK(crc32c(descending) == 0x113FDB5Cu);
+    }
+    CSVKernels::reset();
+
+    // XXH64 (seed 0) reference values; the last input spans a full 32-byte stripe.
+    CHECK(xxh64("") == 0xEF46DB3751D8E999ull);
+    CHECK(xxh64("abc") == 0x44BC2CF5AD770999ull);
+    CHECK(xxh64("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ull);
+
+    // Streaming XXH64 and combined CRC32C give the one-pass value for every split point.
+    std::string text;
+    for (int index = 0; index < 300; ++index) {
+        text.push_back(static_cast<char>("0123456789,\"abcdef\n"[(index * 7 + index / 13) % 19]));
+    }
+    const std::uint32_t whole_crc = crc32c(text);
+    const std::uint64_t whole_xxh = xxh64(text);
+    for (std::size_t split = 0; split <= text.size(); ++split) {
+        const std::string first = text.substr(0, split), second = text.substr(split);
+        CHECK(CSVChecksumState::combineCRC32C(crc32c(first), crc32c(second), second.size()) == whole_crc);
+        CSVXXH64 hash;
+        hash.update(first.data(), first.data() + first.size());
+        hash.update(second.data(), second.data() + second.size());
+        CHECK(hash.digest() == whole_xxh);
+    }
+    // A long second part goes through many squarings of the matrix.
+    const std::string large(3 << 20, 'x');
+    CHECK(CSVChecksumState::combineCRC32C(crc32c(text), crc32c(large), large.size()) == crc32c(text + large));
+
+    // A parallel parse combines the CRC32C of its chunks: it must equal the CRC32C of the file's bytes.
+    corpus::typicalRows("checksum.csv", 300000);
+    std::ifstream file("checksum.csv", std::ios::binary);
+    std::ostringstream bytes;
+    bytes << file.rdbuf();
+    const std::uint32_t expected = crc32c(bytes.str());
+
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    parser.setThreads(4);
+    parser.setChunkSize(256 << 10);
+    parser.setChecksum(CSVChecksum::CRC32C, expected);
+    const auto records = parser.parseObjectsFromFile<std::vector>("checksum.csv");
+    CHECK(records.size() == 300000);
+    CHECK(parser.getStats().chunks > 1);
+    CHECK(parser.getStats().checksum == expected);
+
+    // A mismatch is reported (ChecksumMismatch, printed) and gives no objects.
+    parser.setChecksum(CSVChecksum::CRC32C, expected ^ 1);
+    std::clog.setstate(std::ios::failbit);
+    CHECK(parser.parseObjectsFromFile<std::vector>("checksum.csv").empty());
+    std::clog.clear();
+    CHECK(parser.getStats().checksum == expected);
+
+    parser.setChecksum(CSVChecksum::XXH64, xxh64(bytes.str()));
+    CHECK(parser.parseObjectsFromFile<std::vector>("checksum.csv").size() == 300000);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <thread>
+
+struct Item {
+    int id = 0;
+    std::string name;
+
+    Item() = default;
+    Item(const int id_, std::string name_) : id(id_), name(std::move(name_)) {
+    }
+};
+
+template<typename Function>
+bool throwsOutOfRange(Function &&function) {
+    try {
+        function();
+    } catch (const std::out_of_range &) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    CSVParser<Item, int, std::string> parser;
+    parser.setVerbose(false);
+    parser.setDelimiter(',');   // A header-only file has no second row to detect the delimiter from.
+
+    // A header-only file gives an empty store: every index is out of range.
+    const CSVCompressedRows empty = parser.compressRows(writeFile("compressed_empty.csv", "id,name\n"));
+    CHECK(empty.rows() == 0);
+    auto empty_cursor = empty.cursor();
+    CHECK(throwsOutOfRange([&] { empty_cursor.row(0); }));
+    CHECK(throwsOutOfRange([&] { parser.materialize(empty_cursor, 0); }));
+
+    std::string content = "id,name\n";
+    for (int id = 0; id < 20000; ++id) {
+        content += std::to_string(id) + ",item " + std::to_string(id % 97) + "\n";
+    }
+    const CSVCompressedRows rows = parser.compressRows(writeFile("compressed_rows.csv", content));
+    CHECK(rows.rows() == 20000);
+    CHECK(rows.compressedBytes() < rows.rawBytes());
+
+    auto cursor = rows.cursor();
+    CHECK(cursor.row(0) == "0,item 0");
+    CHECK(cursor.row(19999) == "19999,item 17");
+    const Item item = parser.materialize(cursor, 12345);
+    CHECK(item.id == 12345 && item.name == "item 26");
+    CHECK(throwsOutOfRange([&] { cursor.row(20000); }));
+    CHECK(throwsOutOfRange([&] { parser.materialize(cursor, 20000); }));
+    CHECK(cursor.row(19998) == "19998,item 16");
+
+    // materialize() only reads the parser: threads share one, each with its own cursor.
+    {
+        const auto &shared = parser;
+        std::vector<int> mismatches(4, 0);
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < 4; ++thread) {
+            threads.emplace_back([&, thread] {
+                auto own_cursor = rows.cursor();
+                for (std::size_t row = static_cast<std::size_t>(thread); row < rows.rows(); row += 4) {
+                    const Item read = shared.materialize(own_cursor, row);
+                    mismatches[thread] += read.id != static_cast<int>(row) || read.name != "item " + std::to_string(row % 97);
+                }
+            });
+        }
+        for (std::thread &thread: threads) {
+            thread.join();
+        }
+        CHECK(mismatches == std::vector<int>(4, 0));
+    }
+
+    // A parser that never read the file takes the column count from the store.
+    {
+        CSVParser<std::vector<std::string>, std::string> cells;
+        cells.setVerbose(false);
+        auto cells_cursor = rows.cursor();
+        CHECK(cells.materialize(cells_cursor, 7) == std::vector<std::string>({"7", "item 7"}));
+    }
+
+    return check_failures ? 1 : 0;
+}
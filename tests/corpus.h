@@ -0,0 +1,91 @@
+#ifndef CSV_PARSER_TESTS_CORPUS_H
+#define CSV_PARSER_TESTS_CORPUS_H
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+// Generators of valid CSV files for the worst-case tests and the benchmarks. Every file has the header "id,text,value"
+// (int, std::string, double) except the wide ones, whose rows are all text columns. Each returns its size in bytes.
+namespace corpus {
+
+inline std::size_t fileSize(const std::string &path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    return static_cast<std::size_t>(file.tellg());
+}
+
+// Typical rows: short numbers and text, some of it quoted.
+inline std::size_t typicalRows(const std::string &path, const std::size_t rows) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "id,text,value\n";
+    for (std::size_t row = 0; row < rows; ++row) {
+        file << row << (row % 4 ? ",name " : ",\"name, ") << row % 9973 << (row % 4 ? "," : "\",") << row % 1000 << '.' << row % 7 << '\n';
+    }
+    return fileSize(path);
+}
+
+// One row whose text is a single quoted field of 'bytes' bytes, full of doubled quotes and delimiters.
+inline std::size_t longQuotedRow(const std::string &path, const std::size_t bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "id,text,value\n1,\"";
+    std::string pattern = "lorem,\"\"ipsum\"\" dolor,";
+    for (std::size_t written = 0; written < bytes; written += pattern.size()) {
+        file << pattern;
+    }
+    file << "\",2.5\n";
+    return fileSize(path);
+}
+
+// 'rows' rows of 'columns' short text columns each, under a header of as many columns.
+inline std::size_t wideRows(const std::string &path, const std::size_t columns, const std::size_t rows) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    for (std::size_t column = 0; column < columns; ++column) {
+        file << (column ? ",c" : "c") << column;
+    }
+    file << '\n';
+    for (std::size_t row = 0; row < rows; ++row) {
+        for (std::size_t column = 0; column < columns; ++column) {
+            file << (column ? "," : "") << (column + row) % 100;
+        }
+        file << '\n';
+    }
+    return fileSize(path);
+}
+
+// A run of 'blank_lines' empty CRLF lines right after the header, then one row.
+inline std::size_t blankRun(const std::string &path, const std::size_t blank_lines) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "id,text,value\r\n";
+    for (std::size_t line = 0; line < blank_lines; ++line) {
+        file << "\r\n";
+    }
+    file << "1,last,2.5\r\n";
+    return fileSize(path);
+}
+
+// Rows whose numeric cells never convert (each one fails and is value-initialized).
+inline std::size_t invalidNumbers(const std::string &path, const std::size_t rows) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << "id,text,value\n";
+    for (std::size_t row = 0; row < rows; ++row) {
+        file << "x" << row << ",text,1.5e+x\n";
+    }
+    return fileSize(path);
+}
+
+// Best wall time of 'runs' calls of 'function', in seconds.
+template<typename Function>
+double bestSeconds(const int runs, Function &&function) {
+    double best = 1e300;
+    for (int run = 0; run < runs; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+}
+
+#endif
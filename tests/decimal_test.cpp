@@ -0,0 +1,61 @@
+#include <CSVParser.h>
+#include "check.h"
+
+// Fixed-point decimals: exact parsing and rounding, overflow at Precision digits, and columns of a parsed file. The
+// 38-digit type uses the int128 representation (built with -Wpedantic, see CMakeLists.txt).
+using Money = CSVDecimal<12, 2>;
+using Wide = CSVDecimal<38, 10>;
+
+struct Transfer {
+    int id = 0;
+    Money amount;
+    Wide total;
+
+    Transfer() = default;
+    Transfer(const int id_, const Money amount_, const Wide total_) : id(id_), amount(amount_), total(total_) {
+    }
+};
+
+int main() {
+    Money money;
+    CHECK(Money::parse("12.34", money) && money.raw() == 1234 && money.toString() == "12.34");
+    CHECK(Money::parse("-0.005", money) && money.raw() == -1 && money.toString() == "-0.01");
+    CHECK(Money::parse("+.5", money) && money.toString() == "0.50");
+    CHECK(Money::parse("0001.239999", money) && money.toString() == "1.24");
+    CHECK(Money::parse("9999999999.99", money));
+    CHECK(!Money::parse("10000000000.00", money));
+    CHECK(!Money::parse("9999999999.995", money));     // Rounds past Precision digits.
+    for (const char *invalid: {"", "-", ".", "1e3", "1.2.3", "12abc"}) {
+        CHECK(!Money::parse(invalid, money));
+    }
+
+    Wide wide;
+    CHECK(Wide::parse("9999999999999999999999999999.9999999999", wide));
+    CHECK(wide.toString() == "9999999999999999999999999999.9999999999");
+    CHECK(!Wide::parse("99999999999999999999999999999.9999999999", wide));
+    CHECK(throws<std::overflow_error>([&] { wide += wide; }));
+    Wide negative;
+    CHECK(Wide::parse("-9999999999999999999999999999.9999999999", negative));
+    CHECK(throws<std::overflow_error>([&] { negative -= Wide::fromRaw(1); }));
+    CHECK((wide + negative).raw() == 0);
+    CHECK(Money::fromRaw(5) < Money::fromRaw(7));
+
+    // Padded cells convert like other numbers; unconvertible ones are value-initialized and reported by lintFile().
+    const std::string file = writeFile("decimal.csv", "id,amount,total\n1,10.25 ,1.5\n2,\t-3.10,-2\n3,bad,0\n");
+    CSVParser<Transfer, int, Money, Wide> parser;
+    parser.setVerbose(false);
+    const auto transfers = parser.parseObjectsFromFile<std::vector>(file);
+    CHECK(transfers.size() == 3);
+    Money sum;
+    for (const Transfer &transfer: transfers) {
+        sum += transfer.amount;
+    }
+    CHECK(sum.toString() == "7.15");
+    if (transfers.size() == 3) {
+        CHECK(transfers[1].total.toString() == "-2.0000000000");
+        CHECK(transfers[2].amount.raw() == 0);
+    }
+    CHECK(parser.lintFile(file).error_count == 1);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,98 @@
+#include <CSVParser.h>
+#include "check.h"
+
+struct Pair {
+    int id = 0;
+    std::string text;
+
+    Pair() = default;
+    Pair(const int id_, std::string text_) : id(id_), text(std::move(text_)) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+};
+
+int main() {
+    const std::string semicolons = writeFile("dialect_semicolons.csv", "id;text\n1;one\n2;two\n");
+
+    // The escape character turns out to be the detected delimiter.
+    {
+        CSVParser<Pair, int, std::string> parser;
+        parser.setVerbose(false);
+        parser.setEscape(';');
+        CHECK(throws<InvalidDialect>([&] { parser.lintFile(semicolons); }));
+    }
+
+    // The quote is set to the escape character after it.
+    {
+        CSVParser<Pair, int, std::string> parser;
+        parser.setVerbose(false);
+        parser.setEscape('\\');
+        parser.setQuote('\\');
+        CHECK(throws<InvalidDialect>([&] { parser.lintFile(semicolons); }));
+    }
+
+    // A multi-byte delimiter holding the quote.
+    {
+        CSVParser<Pair, int, std::string> parser;
+        parser.setVerbose(false);
+        parser.setDelimiter("|\"");
+        CHECK(throws<InvalidDialect>([&] { parser.lintFile(semicolons); }));
+    }
+
+    // A valid escape character still parses.
+    {
+        CSVParser<Pair, int, std::string> parser;
+        parser.setVerbose(false);
+        parser.setEscape('\\');
+        const auto pairs = parser.parseObjectsFromFile<std::vector>(writeFile("dialect_escaped.csv", "id;text\n1;a\\;b\n"));
+        CHECK(pairs.size() == 1 && pairs[0].text == "a;b");
+    }
+
+    // Checkpoints are rejected with a delimiter longer than 8 bytes or overlapping bytes.
+    {
+        CSVCheckpoint checkpoint;
+        checkpoint.filename = semicolons;
+        checkpoint.delimiter = '|';
+        checkpoint.delimiter_tail = "||||||||";
+        checkpoint.save("dialect_long.checkpoint");
+        CHECK(throws<InvalidCheckpoint>([] { CSVCheckpoint::load("dialect_long.checkpoint"); }));
+
+        checkpoint.delimiter_tail.clear();
+        checkpoint.escape = '|';
+        checkpoint.save("dialect_overlap.checkpoint");
+        CHECK(throws<InvalidCheckpoint>([] { CSVCheckpoint::load("dialect_overlap.checkpoint"); }));
+
+        checkpoint.escape = '\\';
+        checkpoint.save("dialect_valid.checkpoint");
+        CHECK(CSVCheckpoint::load("dialect_valid.checkpoint").escape == '\\');
+    }
+
+#ifdef CSV_PARSER_POSIX
+    // The index stores the dialect field by field and validates it when opened.
+    {
+        CSVParser<Pair, int, std::string> parser;
+        parser.setVerbose(false);
+        parser.setDelimiter("::");
+        const std::string file = writeFile("dialect_indexed.csv", "id::text\n1::one\n2::two\n");
+        parser.buildIndex<int>(file);
+        {
+            const CSVFileIndex index = CSVFileIndex::open(file);
+            CHECK(index.tokenizer().delimiterText() == "::");
+            const std::optional<Pair> pair = parser.findById(index, 2);
+            CHECK(pair && pair->text == "two");
+        }
+
+        // Corrupts the delimiter length (the byte after the 64-byte fixed part and the 8 delimiter bytes).
+        std::fstream index_file(CSVFileIndex::defaultPath(file), std::ios::binary | std::ios::in | std::ios::out);
+        index_file.seekp(72);
+        index_file.put(static_cast<char>(200));
+        index_file.close();
+        CHECK(throws<InvalidIndex>([&] { CSVFileIndex::open(file); }));
+    }
+#endif
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#include <CSVParser.h>
+#include "check.h"
+
+// Enum columns: every declared text maps to its value through the compile-time perfect hash, near misses do not,
+// and unknown texts take the fallback or fail to convert (reported by lintFile()).
+enum class Status { Unknown, Active, Suspended, Closed };
+
+template<>
+struct CSVEnumTraits<Status> {
+    static constexpr std::array<std::pair<std::string_view, Status>, 3> values{{
+        {"ACTIVE", Status::Active}, {"SUSPENDED", Status::Suspended}, {"CLOSED", Status::Closed}}};
+};
+
+enum Color { Red = 1, Green, Blue };
+
+template<>
+struct CSVEnumTraits<Color> {
+    static constexpr std::array<std::pair<std::string_view, Color>, 3> values{{{"red", Red}, {"green", Green}, {"blue", Blue}}};
+    static constexpr Color fallback = Blue;
+};
+
+// 256 values, the most a table supports: "c000" to "c255".
+enum class Code : std::uint8_t {};
+
+constexpr auto code_texts = [] {
+    std::array<std::array<char, 4>, 256> texts{};
+    for (std::size_t code = 0; code < texts.size(); ++code) {
+        texts[code] = {'c', static_cast<char>('0' + code / 100), static_cast<char>('0' + code / 10 % 10), static_cast<char>('0' + code % 10)};
+    }
+    return texts;
+}();
+
+template<>
+struct CSVEnumTraits<Code> {
+    static constexpr auto values = [] {
+        std::array<std::pair<std::string_view, Code>, 256> values{};
+        for (std::size_t code = 0; code < values.size(); ++code) {
+            values[code] = {std::string_view(code_texts[code].data(), 4), static_cast<Code>(code)};
+        }
+        return values;
+    }();
+};
+
+struct Account {
+    int id = 0;
+    Status status = Status::Unknown;
+    Color color = Red;
+
+    Account() = default;
+    Account(const int id_, const Status status_, const Color color_) : id(id_), status(status_), color(color_) {
+    }
+};
+
+// The lookup runs at compile time as well.
+static_assert([] {
+    Status status{};
+    return CSVEnumTable<Status>::lookup("CLOSED", status) && status == Status::Closed;
+}());
+
+int main() {
+    Code code{};
+    bool all = true;
+    for (std::size_t index = 0; index < 256; ++index) {
+        all = all && CSVCellParser<Code>::parse(std::string_view(code_texts[index].data(), 4), code) &&
+              static_cast<std::size_t>(code) == index;
+    }
+    CHECK(all);
+    for (const std::string_view miss: {"c256", "c25", "c2555", "C001", "", "c0 0"}) {
+        CHECK(!CSVCellParser<Code>::parse(miss, code));
+    }
+
+    Status status{};
+    CHECK(CSVCellParser<Status>::parse(" SUSPENDED\t", status) && status == Status::Suspended);
+    for (const std::string_view miss: {"ACTIV", "ACTIVEX", "active", "", "CLOSED,"}) {
+        CHECK(!CSVCellParser<Status>::parse(miss, status));
+    }
+    Color color{};
+    CHECK(CSVCellParser<Color>::parse("green", color) && color == Green);
+    CHECK(CSVCellParser<Color>::parse("purple", color) && color == Blue);
+    CHECK(CSVCellParser<Color>::parse("", color) && color == Blue);
+
+    writeFile("enum.csv", "id,status,color\n1,ACTIVE,red\n2,SUSPENDED,green\n3,bogus,purple\n4, CLOSED ,blue\n");
+    CSVParser<Account, int, Status, Color> parser;
+    parser.setVerbose(false);
+    const auto accounts = parser.parseObjectsFromFile<std::vector>("enum.csv");
+    CHECK(accounts.size() == 4);
+    if (accounts.size() == 4) {
+        CHECK(accounts[0].status == Status::Active && accounts[0].color == Red);
+        CHECK(accounts[1].status == Status::Suspended && accounts[1].color == Green);
+        CHECK(accounts[2].status == Status::Unknown && accounts[2].color == Blue);
+        CHECK(accounts[3].status == Status::Closed && accounts[3].color == Blue);
+    }
+
+    // Only the status column has no fallback: its unknown text is the one error.
+    const CSVLintReport report = parser.lintFile("enum.csv");
+    CHECK(report.rows == 4 && report.error_count == 1);
+    CHECK(report.errors.size() == 1 && report.errors[0].line == 4 && report.errors[0].column == 1);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+#include <CSVParser.h>
+#include "check.h"
+
+// Key lookups through an on-disk index, and indexes whose slot table does not match the file, which open() rejects.
+struct Item {
+    int id = 0;
+    std::string name;
+
+    Item() = default;
+    Item(const int id_, std::string name_) : id(id_), name(std::move(name_)) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+};
+
+#ifdef CSV_PARSER_POSIX
+
+// Header fields: slot_count at byte 16, entries at 24, columns_offset at 48.
+void corrupt(const std::string &path, const std::size_t offset, const std::uint64_t value) {
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(static_cast<std::streamoff>(offset));
+    file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+std::uint64_t field(const std::string &path, const std::size_t offset) {
+    std::ifstream file(path, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    std::uint64_t value = 0;
+    file.read(reinterpret_cast<char *>(&value), sizeof(value));
+    return value;
+}
+
+int main() {
+    std::string content = "id,name\n";
+    for (int row = 0; row < 50; ++row) {
+        content += std::format("{},item {}\n", row * 3, row);
+    }
+    const std::string file = writeFile("file_index.csv", content);
+
+    CSVParser<Item, int, std::string> parser;
+    parser.setVerbose(false);
+    parser.buildIndex<int>(file);
+    const std::string path = CSVFileIndex::defaultPath(file);
+    {
+        const CSVFileIndex index = CSVFileIndex::open(file);
+        CHECK(index.entries() == 50);
+        CHECK(index.columns() == std::vector<std::string>({"id", "name"}));
+        const std::optional<Item> item = parser.findById(index, 42);
+        CHECK(item && item->name == "item 14");
+        CHECK(!parser.findById(index, 43));
+    }
+
+    const std::uint64_t slot_count = field(path, 16);
+    const std::uint64_t columns_offset = field(path, 48);
+    const auto rejected = [&](const std::size_t offset, const std::uint64_t value, const std::uint64_t original) {
+        corrupt(path, offset, value);
+        const bool result = throws<InvalidIndex>([&] { CSVFileIndex::open(file); });
+        corrupt(path, offset, original);
+        return result;
+    };
+    CHECK(rejected(16, 0, slot_count));
+    CHECK(rejected(16, slot_count - 1, slot_count));       // Not a power of two.
+    CHECK(rejected(16, slot_count * 2, slot_count));       // Slots past the column names.
+    CHECK(rejected(16, 1ull << 62, slot_count));           // Overflows slot_count * sizeof(Slot).
+    CHECK(rejected(24, slot_count, 50));                   // A full table.
+    CHECK(rejected(48, (columns_offset + 1) << 20, columns_offset));
+    CHECK(!throws<InvalidIndex>([&] { CSVFileIndex::open(file); }));
+
+    return check_failures ? 1 : 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,86 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <sstream>
+
+// Incremental reparsing: after small edits only the chunks around them are parsed again, the objects always equal a
+// full parse, and a change of dialect, a failed parse or disabling the cache never reuses stale objects.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+std::string readFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+int main() {
+    corpus::typicalRows("incremental.csv", 300000);
+    std::string text = readFile("incremental.csv");
+
+    Parser reference;
+    reference.setVerbose(false);
+    Parser parser;
+    parser.setVerbose(false);
+    parser.setThreads(4);
+    parser.setIncremental(true);
+
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv") == reference.parseObjectsFromFile<std::vector>("incremental.csv"));
+    const std::size_t chunks = parser.getStats().chunks;
+    CHECK(chunks > 8 && parser.getStats().reused_chunks == 0);
+
+    // The same file again: every chunk comes from the cache.
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv").size() == 300000);
+    CHECK(parser.getStats().reused_chunks == chunks);
+
+    // A row inserted in the middle and a value edited near the end only invalidate the chunks around them.
+    text.insert(text.find('\n', text.size() / 2) + 1, "999999,\"inserted, row\",1.5\n");
+    const std::size_t late = text.find('\n', text.size() - 5000) + 1;
+    text[late] = text[late] == '1' ? '2' : '1';
+    writeFile("incremental.csv", text);
+    const auto edited = parser.parseObjectsFromFile<std::vector>("incremental.csv");
+    CHECK(edited == reference.parseObjectsFromFile<std::vector>("incremental.csv"));
+    CHECK(edited.size() == 300001 && parser.getStats().rows == 300001);
+    std::cout << std::format("After two edits: {} of {} chunks reused", parser.getStats().reused_chunks, parser.getStats().chunks) << std::endl;
+    CHECK(parser.getStats().reused_chunks + 6 >= parser.getStats().chunks && parser.getStats().reused_chunks < parser.getStats().chunks);
+
+    // Pointer containers share the cache.
+    CHECK(parser.parsePointerObjectsFromFile<std::vector>("incremental.csv").size() == 300001);
+    CHECK(parser.getStats().reused_chunks == parser.getStats().chunks);
+
+    // Enabling UTF-8 validation drops the cache. A failed parse (invalid UTF-8 in one chunk) returns nothing and keeps
+    // the cache of the last good version.
+    parser.setValidateUTF8(true);
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv") == edited);
+    CHECK(parser.getStats().reused_chunks == 0);
+    std::string invalid = text;
+    invalid[invalid.find("name", invalid.size() / 3)] = '\xFF';
+    writeFile("incremental.csv", invalid);
+    std::clog.setstate(std::ios::failbit);
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv").empty());
+    std::clog.clear();
+    writeFile("incremental.csv", text);
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv") == edited);
+    CHECK(parser.getStats().reused_chunks == parser.getStats().chunks);
+
+    // Disabling the cache drops it.
+    parser.setIncremental(false);
+    parser.setIncremental(true);
+    CHECK(parser.parseObjectsFromFile<std::vector>("incremental.csv") == edited);
+    CHECK(parser.getStats().reused_chunks == 0);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,145 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <random>
+
+// Every kernel level the CPU supports must agree with the scalar kernels. Inputs put the interesting byte on both
+// sides of the 16, 32 and 64-byte vector boundaries, starting from several alignments. Results with a known answer
+// (positions, digit counts, UTF-8 validity) are also checked at each level.
+constexpr std::size_t boundaries[] = {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129};
+
+// Results of one kernel level over all the inputs, compared with the scalar ones.
+struct Results {
+    std::vector<std::ptrdiff_t> structural;
+    std::vector<std::size_t> digits;
+    std::vector<std::size_t> counts;
+    std::vector<bool> utf8;
+    std::vector<bool> decodes;
+    std::vector<std::uint32_t> crcs;
+    std::vector<std::string> decoded;
+
+    bool operator==(const Results &) const = default;
+};
+
+// Valid and invalid multi-byte sequences, placed after 'padding' ASCII bytes so they straddle vector boundaries.
+const std::vector<std::pair<std::string, bool>> utf8_sequences = {
+    {"\xC3\xA9", true},                  // U+00E9
+    {"\xE2\x82\xAC", true},              // U+20AC
+    {"\xF0\x9F\x98\x80", true},          // U+1F600
+    {"\xC3", false},                     // Truncated
+    {"\xE2\x82", false},
+    {"\xF0\x9F\x98", false},
+    {"\x80", false},                     // Stray continuation byte
+    {"\xC0\x80", false},                 // Overlong
+    {"\xE0\x80\xAF", false},
+    {"\xED\xA0\x80", false},             // Surrogate
+    {"\xF4\x90\x80\x80", false},         // Above U+10FFFF
+    {"\xFF", false},
+};
+
+Results run() {
+    Results results;
+    std::mt19937 random(42);
+
+    // Structural characters: a quote or a delimiter at a boundary, searched from several starting alignments.
+    for (const std::size_t position: boundaries) {
+        for (const char symbol: {'"', ','}) {
+            std::string text(160, 'a');
+            text[position] = symbol;
+            for (std::size_t start = 0; start <= std::min<std::size_t>(position, 3); ++start) {
+                const char *begin = text.data() + start, *end = text.data() + text.size();
+                results.structural.push_back(CSVKernels::findStructural(begin, end, '"', ',') - text.data());
+                CHECK(results.structural.back() == static_cast<std::ptrdiff_t>(position));
+                results.structural.push_back(CSVKernels::findStructural(begin, end, symbol, symbol) - text.data());
+                // Not found: the end is returned.
+                results.structural.push_back(CSVKernels::findStructural(begin, end, '\n', '\n') - text.data());
+                // The range stops right before the symbol.
+                results.structural.push_back(CSVKernels::findStructural(begin, text.data() + position, symbol, symbol) - text.data());
+            }
+        }
+    }
+
+    // Digit runs ending at a boundary.
+    for (const std::size_t length: boundaries) {
+        for (std::size_t start = 0; start < 4; ++start) {
+            std::string text(start, 'x');
+            text += std::string(length, '7');
+            text += "x123";
+            results.digits.push_back(CSVKernels::countDigits(text.data() + start, text.data() + text.size()));
+            CHECK(results.digits.back() == length);
+            results.digits.push_back(CSVKernels::countDigits(text.data() + start, text.data() + start + length));
+        }
+    }
+
+    // Byte counts and CRC32C over random buffers of boundary lengths.
+    for (const std::size_t length: boundaries) {
+        std::string text(length + 64, '\0');
+        for (char &byte: text) {
+            byte = static_cast<char>("ab,\"\n"[random() % 5]);
+        }
+        for (std::size_t start = 0; start < 4; ++start) {
+            const char *begin = text.data() + start, *end = begin + length;
+            results.counts.push_back(CSVKernels::countByte(begin, end, ','));
+            results.counts.push_back(CSVKernels::countByte(begin, end, '\n'));
+            results.crcs.push_back(CSVKernels::crc32c(0, begin, end));
+        }
+    }
+
+    // UTF-8 sequences split across each boundary.
+    for (std::size_t padding = 0; padding < 70; ++padding) {
+        for (const auto &[sequence, valid]: utf8_sequences) {
+            const std::string text = std::string(padding, 'a') + sequence + std::string(40, 'b');
+            results.utf8.push_back(CSVKernels::validateUTF8(text.data(), text.data() + text.size()));
+            CHECK(results.utf8.back() == valid);
+        }
+    }
+
+    // Hex and base64 digits of boundary lengths, one invalid digit at the end.
+    for (const std::size_t length: boundaries) {
+        std::string hex, base64;
+        for (std::size_t index = 0; index < length * 2; ++index) {
+            hex.push_back("0123456789abcdefABCDEF"[random() % 22]);
+        }
+        for (std::size_t index = 0; index < length * 4; ++index) {
+            base64.push_back("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[random() % 64]);
+        }
+        std::string decoded(length * 3, '\0');
+        auto *out = reinterpret_cast<std::uint8_t *>(decoded.data());
+        CHECK(CSVKernels::decodeHex(hex.data(), hex.data() + hex.size(), out));
+        results.decoded.push_back(decoded.substr(0, length));
+        CHECK(CSVKernels::decodeBase64(base64.data(), base64.data() + base64.size(), out));
+        results.decoded.push_back(decoded);
+        if (length) {
+            hex.back() = 'g';
+            base64.back() = '=';
+            results.decodes.push_back(CSVKernels::decodeHex(hex.data(), hex.data() + hex.size(), out));
+            results.decodes.push_back(CSVKernels::decodeBase64(base64.data(), base64.data() + base64.size(), out));
+            CHECK(!results.decodes.end()[-1] && !results.decodes.end()[-2]);
+        }
+    }
+    return results;
+}
+
+int main() {
+    CSVKernels::force(CSVKernelLevel::Scalar);
+    const Results scalar = run();
+
+    for (const CSVKernelLevel level: {CSVKernelLevel::SSE42, CSVKernelLevel::AVX2, CSVKernelLevel::AVX512}) {
+        if (level > CSVKernels::detect()) {
+            continue;
+        }
+        CSVKernels::force(level);
+        const Results vector = run();
+        std::cout << std::format("{}: compared with scalar", CSVKernels::active().name) << std::endl;
+        CHECK(vector.structural == scalar.structural);
+        CHECK(vector.digits == scalar.digits);
+        CHECK(vector.counts == scalar.counts);
+        CHECK(vector.utf8 == scalar.utf8);
+        CHECK(vector.decodes == scalar.decodes);
+        CHECK(vector.crcs == scalar.crcs);
+        CHECK(vector.decoded == scalar.decoded);
+    }
+    CSVKernels::reset();
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,55 @@
+#include <CSVParser.h>
+#include "check.h"
+
+struct Reading {
+    int id = 0;
+    int count = 0;
+    float value = 0;
+
+    Reading() = default;
+    Reading(const int id_, const int count_, const float value_) : id(id_), count(count_), value(value_) {
+    }
+};
+
+int main() {
+    CSVParser<Reading, int, int, float> parser;
+    parser.setVerbose(false);
+
+    // Well-formed numbers, blanks around them and signs included.
+    const std::string valid = writeFile("lint_valid.csv", "id,count,value\n1,2,3.5\n2, -7,+1e3\n3,\t0,-0.25\n4,12 , 3.5\t\n");
+    const CSVLintReport clean = parser.lintFile(valid);
+    CHECK(clean.ok());
+    CHECK(clean.rows == 4);
+    const auto padded = parser.parseObjectsFromFile<std::vector>(valid);
+    CHECK(padded.size() == 4);
+    if (padded.size() == 4) {
+        CHECK(padded[1].count == -7);
+        CHECK(padded[3].count == 12 && padded[3].value == 3.5f);
+    }
+
+    // Numbers followed by other text are invalid, not truncated.
+    const std::string invalid = writeFile("lint_trailing.csv", "id,count,value\n1,12abc,1.5\n2,3,1.5x\n3,4 x,2\n4,5,6\n");
+    const CSVLintReport report = parser.lintFile(invalid);
+    CHECK(report.error_count == 3);
+    CHECK(report.errors.size() == 3);
+    if (report.errors.size() == 3) {
+        CHECK(report.errors[0].line == 2 && report.errors[0].column == 1);
+        CHECK(report.errors[1].line == 3 && report.errors[1].column == 2);
+        CHECK(report.errors[2].line == 4 && report.errors[2].column == 1);
+        for (const CSVLintError &error: report.errors) {
+            CHECK(error.issue == CSVLintIssue::InvalidValue);
+        }
+    }
+
+    // Parsing value-initializes the same cells instead of keeping the leading digits.
+    const auto readings = parser.parseObjectsFromFile<std::vector>(invalid);
+    CHECK(readings.size() == 4);
+    if (readings.size() == 4) {
+        CHECK(readings[0].count == 0);
+        CHECK(readings[1].value == 0);
+        CHECK(readings[2].count == 0);
+        CHECK(readings[3].count == 5 && readings[3].value == 6);
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <filesystem>
+#include <sstream>
+
+// CSV-to-CSV normalization: minimal quoting, projection, line endings, a parallel round trip that parses back to the
+// same objects, and output dialects that could not be read back.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+std::string readFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+int main() {
+    writeFile("normalize.csv", "id;text;value\r\n1;\"a;b\";1.5\r\n\r\n2;\"say \"\"hi\"\", ok\";2.5\r\n3;short\r\n");
+    Parser parser;
+    parser.setVerbose(false);
+    CHECK(parser.normalizeFile("normalize.csv", "normalize.out") == 3);
+    CHECK(readFile("normalize.out") == "id,text,value\n1,a;b,1.5\n2,\"say \"\"hi\"\", ok\",2.5\n3,short,\n");
+
+    CSVNormalizeOptions options;
+    options.delimiter = '\t';
+    options.quote = '\'';
+    options.columns = {"value", "id"};
+    options.crlf = true;
+    CHECK(parser.normalizeFile("normalize.csv", "normalize.out", options) == 3);
+    CHECK(readFile("normalize.out") == "value\tid\r\n1.5\t1\r\n2.5\t2\r\n\t3\r\n");
+    options.header = false;
+    options.columns = {"text"};
+    parser.normalizeFile("normalize.csv", "normalize.out", options);
+    CHECK(readFile("normalize.out") == "a;b\r\nsay \"hi\", ok\r\nshort\r\n");
+
+    // Output dialects whose fields could not be told apart are rejected before the output file is created.
+    std::filesystem::remove("normalize_invalid.out");
+    for (const auto &[delimiter, quote]: std::vector<std::pair<char, char>>{{',', ','}, {'\n', '"'}, {'\r', '"'}, {',', '\n'}, {';', '\r'}}) {
+        CSVNormalizeOptions invalid;
+        invalid.delimiter = delimiter;
+        invalid.quote = quote;
+        CHECK(throws<InvalidDialect>([&] { parser.normalizeFile("normalize.csv", "normalize_invalid.out", invalid); }));
+    }
+    CHECK(!std::filesystem::exists("normalize_invalid.out"));
+    options.columns = {"missing"};
+    CHECK(throws<UnknownColumn>([&] { parser.normalizeFile("normalize.csv", "normalize.out", options); }));
+
+    // A large file transcoded in parallel chunks parses back to the same objects.
+    corpus::typicalRows("normalize_large.csv", 300000);
+    Parser parallel;
+    parallel.setVerbose(false);
+    parallel.setThreads(4);
+    CSVNormalizeOptions semicolon;
+    semicolon.delimiter = ';';
+    CHECK(parallel.normalizeFile("normalize_large.csv", "normalize_large.out", semicolon) == 300000);
+    CHECK(parallel.getStats().chunks > 1);
+    // A parser keeps the dialect it detected, so each file is read back with its own.
+    Parser original_reader, normalized_reader;
+    original_reader.setVerbose(false);
+    normalized_reader.setVerbose(false);
+    const auto original = original_reader.parseObjectsFromFile<std::vector>("normalize_large.csv");
+    CHECK(original.size() == 300000 && normalized_reader.parseObjectsFromFile<std::vector>("normalize_large.out") == original);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <unordered_map>
+
+// Parallel parsing must give the objects of a sequential parse, in file order, whatever the thread count and chunk
+// size. Chunk sizes are tuned from the sampled row length and clamped; small inputs stay on the calling thread.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+std::vector<Record> parse(Parser &parser, const std::string &path) {
+    parser.setVerbose(false);
+    return parser.parseObjectsFromFile<std::vector>(path);
+}
+
+int main() {
+    corpus::typicalRows("parallel.csv", 300000);
+
+    Parser sequential;
+    const std::vector<Record> expected = parse(sequential, "parallel.csv");
+    CHECK(expected.size() == 300000);
+    CHECK(sequential.getStats().chunks == 1 && sequential.getStats().chunk_size == 0);
+    if (expected.size() == 300000) {
+        CHECK(expected[1].text == "name 1" && expected[4].text == "name, 4");
+    }
+
+    // Automatic and explicit thread counts, with the tuned chunk size.
+    for (const unsigned threads: {0u, 2u, 4u, 7u}) {
+        Parser parallel;
+        parallel.setThreads(threads);
+        CHECK(parse(parallel, "parallel.csv") == expected);
+        const CSVStats &stats = parallel.getStats();
+        CHECK(stats.rows == expected.size());
+        if (threads != 1 && (threads || std::thread::hardware_concurrency() > 1)) {
+            CHECK(stats.chunks > 1);
+            CHECK(stats.chunk_size >= 256 << 10 && stats.chunk_size <= 16 << 20);
+            CHECK(stats.threads >= 1 && stats.threads <= std::max(threads, std::thread::hardware_concurrency()));
+        }
+    }
+
+    // A chunk size set by hand, smaller than most rows' distance to a boundary.
+    {
+        Parser parallel;
+        parallel.setThreads(3);
+        parallel.setChunkSize(100003);
+        CHECK(parse(parallel, "parallel.csv") == expected);
+        CHECK(parallel.getStats().chunk_size == 100003);
+        CHECK(parallel.getStats().chunks > 50);
+    }
+
+    // Keyed containers get every row as well.
+    {
+        Parser parallel;
+        parallel.setVerbose(false);
+        parallel.setThreads(4);
+        const auto by_id = parallel.parseObjectsFromFile<std::unordered_map, int>("parallel.csv");
+        CHECK(by_id.size() == expected.size());
+        CHECK(by_id.count(123456) && by_id.at(123456) == expected[123456]);
+        const auto pointers = parallel.parsePointerObjectsFromFile<std::vector>("parallel.csv");
+        CHECK(pointers.size() == expected.size() && *pointers.back() == expected.back());
+    }
+
+    // Below 4 MB the file is parsed on the calling thread.
+    {
+        corpus::typicalRows("parallel_small.csv", 1000);
+        Parser parallel;
+        parallel.setThreads(4);
+        CHECK(parse(parallel, "parallel_small.csv").size() == 1000);
+        CHECK(parallel.getStats().chunks == 1 && parallel.getStats().threads == 1);
+    }
+
+    return check_failures ? 1 : 0;
+}
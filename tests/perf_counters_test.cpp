@@ -0,0 +1,65 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+// Hardware counters: parses give the same objects with and without them, on one and several threads. Where Linux
+// perf counters can be opened, the row loop and the sampled stages are counted; elsewhere nothing is reported.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+int main() {
+    corpus::typicalRows("perf_counters.csv", 300000);
+    CSVParser<Record, int, std::string, double> reference;
+    reference.setVerbose(false);
+    const auto expected = reference.parseObjectsFromFile<std::vector>("perf_counters.csv");
+    CHECK(!reference.getStats().perf.available);
+
+    for (const unsigned threads: {1u, 4u}) {
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        parser.setThreads(threads);
+        parser.setPerfCounters(true);
+        CHECK(parser.parseObjectsFromFile<std::vector>("perf_counters.csv") == expected);
+
+        const CSVStats &stats = parser.getStats();
+        const CSVPerfStats &perf = stats.perf;
+        if (!perf.available) {
+            std::cout << std::format("{} thread(s): perf counters unavailable, only the objects are checked", threads) << std::endl;
+            CHECK(perf.total.instructions == 0 && perf.tokenize.instructions == 0 && perf.sampled_rows == 0);
+            continue;
+        }
+        std::cout << std::format("{} thread(s): {:.1f} instructions/row, {:.2f} instructions/byte, {} sampled rows", threads,
+                                 stats.perRow(perf.total.instructions), stats.perByte(perf.total.instructions),
+                                 perf.sampled_rows) << std::endl;
+        // About one row in 64 is sampled.
+        const double sampled = static_cast<double>(perf.sampled_rows) * CSVPerfStats::sample_every / static_cast<double>(expected.size());
+        CHECK(sampled > 0.9 && sampled < 1.1);
+        CHECK(perf.total.instructions > expected.size() && perf.total.cycles > 0);
+        CHECK(perf.tokenize.instructions > 0 && perf.convert.instructions > 0 && perf.insert.instructions > 0);
+        // The stages are estimates, close to the whole loop at most. Sampling every 64th row would count each reallocation
+        // of the result vector (at power-of-two sizes) 64 times over: the insert stage alone was then 3 times the loop.
+        const std::uint64_t stages = perf.tokenize.instructions + perf.convert.instructions + perf.insert.instructions;
+        std::cout << std::format("  tokenize {:.1f}, convert {:.1f}, insert {:.1f} instructions/row", stats.perRow(perf.tokenize.instructions),
+                                 stats.perRow(perf.convert.instructions), stats.perRow(perf.insert.instructions)) << std::endl;
+        CHECK(stages < perf.total.instructions * 5 / 4);
+    }
+
+    // Disabled again: nothing is counted.
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    parser.setPerfCounters(true);
+    parser.setPerfCounters(false);
+    CHECK(parser.parseObjectsFromFile<std::vector>("perf_counters.csv") == expected);
+    CHECK(!parser.getStats().perf.available && parser.getStats().perf.total.cycles == 0);
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,175 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <cstdlib>
+#include <map>
+#include <thread>
+
+// Throughput regression check: each scenario is parsed several times and its best throughput (getStats()) is compared
+// against the baseline recorded for this machine class in baselines.txt. A scenario slower than its baseline by more
+// than the tolerance fails the test.
+//
+//   regression_bench <baselines.txt> [--record]
+//
+// CSV_BENCH_MACHINE overrides the machine class (default '<kernel>-<threads>t', e.g. 'avx2-8t').
+// CSV_BENCH_TOLERANCE overrides the allowed slowdown (default 0.30, i.e. 30 %).
+// Without a baseline for the machine class the figures are only printed; --record stores them. Builds with
+// assertions (no NDEBUG) are not comparable to the Release baselines and skip the test (exit code 77).
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+constexpr int runs = 5;
+
+// Best throughput of 'runs' parses, in MB/s.
+template<typename Parse>
+double bestThroughput(Parse &&parse) {
+    double best = 0;
+    for (int run = 0; run < runs; ++run) {
+        best = std::max(best, parse().throughput() / 1e6);
+    }
+    return best;
+}
+
+CSVStats parseRecords(const std::string &path) {
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    const auto records = parser.parseObjectsFromFile<std::vector>(path);
+    CHECK(!records.empty());
+    return parser.getStats();
+}
+
+CSVStats streamRecords(const std::string &path) {
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    std::size_t rows = 0;
+    parser.parseObjectsIntoSink(path, [&rows](Record &&) { ++rows; });
+    CHECK(rows > 0);
+    return parser.getStats();
+}
+
+CSVStats parseTextRows(const std::string &path) {
+    CSVParser<std::vector<std::string>, std::string> parser;
+    parser.setVerbose(false);
+    const auto rows = parser.parseObjectsFromFile<std::vector>(path);
+    CHECK(!rows.empty());
+    return parser.getStats();
+}
+
+std::string machineClass() {
+    if (const char *machine = std::getenv("CSV_BENCH_MACHINE"); machine && *machine) {
+        return machine;
+    }
+    return std::format("{}-{}t", CSVKernels::active().name, std::max(1u, std::thread::hardware_concurrency()));
+}
+
+double tolerance() {
+    const char *value = std::getenv("CSV_BENCH_TOLERANCE");
+    return value && *value ? std::strtod(value, nullptr) : 0.30;
+}
+
+// Lines of 'machine scenario MB/s'; '#' starts a comment.
+std::map<std::string, std::map<std::string, double>> readBaselines(const std::string &path) {
+    std::map<std::string, std::map<std::string, double>> baselines;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line.substr(0, line.find('#')));
+        std::string machine, scenario;
+        double throughput = 0;
+        if (fields >> machine >> scenario >> throughput) {
+            baselines[machine][scenario] = throughput;
+        }
+    }
+    return baselines;
+}
+
+// Machine classes with baselines, comma-separated.
+std::string recordedClasses(const std::map<std::string, std::map<std::string, double>> &baselines) {
+    std::string classes;
+    for (const auto &[machine, scenarios]: baselines) {
+        classes += (classes.empty() ? "" : ", ") + machine;
+    }
+    return classes.empty() ? "none" : classes;
+}
+
+void writeBaselines(const std::string &path, const std::map<std::string, std::map<std::string, double>> &baselines) {
+    std::ofstream file(path, std::ios::trunc);
+    file << "# Throughput baselines of regression_bench (Release build), in MB/s: machine_class scenario throughput\n";
+    for (const auto &[machine, scenarios] : baselines) {
+        for (const auto &[scenario, throughput] : scenarios) {
+            file << std::format("{} {} {:.1f}\n", machine, scenario, throughput);
+        }
+    }
+}
+
+int main(const int argc, char **argv) {
+    if (argc < 2) {
+        std::cerr << "usage: regression_bench <baselines.txt> [--record]" << std::endl;
+        return 2;
+    }
+#ifndef NDEBUG
+    std::cout << "Not an optimized build: baselines are recorded with a Release build." << std::endl;
+    return 77;
+#endif
+    const std::string baselines_path = argv[1];
+    const bool record = argc > 2 && std::string_view(argv[2]) == "--record";
+
+    corpus::typicalRows("bench_typical.csv", 1000000);
+    corpus::longQuotedRow("bench_long_quoted_row.csv", 32 << 20);
+    corpus::wideRows("bench_wide_rows.csv", 5000, 400);
+    corpus::blankRun("bench_blank_run.csv", 8 << 20);
+    corpus::invalidNumbers("bench_invalid_numbers.csv", 500000);
+
+    const std::map<std::string, double> measured = {
+        {"typical", bestThroughput([] { return parseRecords("bench_typical.csv"); })},
+        {"typical_sink", bestThroughput([] { return streamRecords("bench_typical.csv"); })},
+        {"long_quoted_row", bestThroughput([] { return parseRecords("bench_long_quoted_row.csv"); })},
+        {"wide_rows", bestThroughput([] { return parseTextRows("bench_wide_rows.csv"); })},
+        {"blank_run", bestThroughput([] { return parseRecords("bench_blank_run.csv"); })},
+        {"invalid_numbers", bestThroughput([] { return parseRecords("bench_invalid_numbers.csv"); })},
+    };
+
+    const std::string machine = machineClass();
+    auto baselines = readBaselines(baselines_path);
+    if (record) {
+        baselines[machine] = measured;
+        writeBaselines(baselines_path, baselines);
+        std::cout << std::format("Recorded {} baselines for '{}' in {}", measured.size(), machine, baselines_path) << std::endl;
+        return check_failures ? 1 : 0;
+    }
+
+    const auto found = baselines.find(machine);
+    if (found == baselines.end()) {
+        std::cout << std::format("No baselines for '{}' in {} (only for: {}): throughput is NOT checked on this "
+                                 "machine class. Run with --record to store these figures.", machine, baselines_path,
+                                 recordedClasses(baselines)) << std::endl;
+        for (const auto &[scenario, throughput] : measured) {
+            std::cout << std::format("{} {} {:.1f}", machine, scenario, throughput) << std::endl;
+        }
+        return check_failures ? 1 : 0;
+    }
+
+    std::cout << std::format("Baselines exist for: {}. Other machine classes are not checked.", recordedClasses(baselines))
+              << std::endl;
+    const double allowed = tolerance();
+    for (const auto &[scenario, throughput] : measured) {
+        const auto baseline = found->second.find(scenario);
+        if (baseline == found->second.end()) {
+            std::cout << std::format("{}: {:.1f} MB/s (no baseline)", scenario, throughput) << std::endl;
+            continue;
+        }
+        const double change = throughput / baseline->second - 1;
+        std::cout << std::format("{}: {:.1f} MB/s, baseline {:.1f} MB/s ({:+.1f} %)", scenario, throughput,
+                                 baseline->second, change * 100) << std::endl;
+        CHECK(change >= -allowed);
+    }
+    return check_failures ? 1 : 0;
+}
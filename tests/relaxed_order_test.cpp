@@ -0,0 +1,76 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <algorithm>
+#include <set>
+#include <unordered_map>
+
+// Relaxed order: parallel workers fill their own containers, merged at the end. A vector holds the same objects as an
+// ordered parse (in any order); keyed containers hold one of the rows of each key.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+
+    bool operator==(const Record &) const = default;
+
+    bool operator<(const Record &other) const {
+        return std::tie(id, text, value) < std::tie(other.id, other.text, other.value);
+    }
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+int main() {
+    corpus::typicalRows("relaxed.csv", 300000);
+
+    Parser ordered;
+    ordered.setVerbose(false);
+    ordered.setThreads(4);
+    std::vector<Record> expected = ordered.parseObjectsFromFile<std::vector>("relaxed.csv");
+    CHECK(expected.size() == 300000);
+
+    Parser relaxed;
+    relaxed.setVerbose(false);
+    relaxed.setThreads(4);
+    relaxed.setChunkSize(300000);
+    relaxed.setOrdered(false);
+
+    std::vector<Record> objects = relaxed.parseObjectsFromFile<std::vector>("relaxed.csv");
+    CHECK(relaxed.getStats().chunks > 1);
+    std::sort(objects.begin(), objects.end());
+    std::sort(expected.begin(), expected.end());
+    CHECK(objects == expected);
+
+    const auto set = relaxed.parseObjectsFromFile<std::set>("relaxed.csv");
+    CHECK(set.size() == expected.size() && *set.begin() == expected.front());
+
+    const auto pointers = relaxed.parsePointerObjectsFromFile<std::vector>("relaxed.csv");
+    CHECK(pointers.size() == expected.size());
+
+    // Every id twice, in rows far apart: the map keeps one row per key, either of them.
+    {
+        std::string content = "id,text,value\n";
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int id = 0; id < 150000; ++id) {
+                content += std::format("{},pass {},{}.5\n", id, pass, id % 100);
+            }
+        }
+        writeFile("relaxed_duplicates.csv", content);
+        const auto by_id = relaxed.parseObjectsFromFile<std::unordered_map, int>("relaxed_duplicates.csv");
+        CHECK(by_id.size() == 150000);
+        const auto found = by_id.find(4242);
+        CHECK(found != by_id.end() && (found->second.text == "pass 0" || found->second.text == "pass 1"));
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <unordered_map>
+
+// Parse sessions advance in steps bounded by rows or time, keep their position between steps, and end with the
+// objects of a one-shot parse. Sessions of one parser are independent.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+int main() {
+    corpus::typicalRows("session.csv", 300000);
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    const std::vector<Record> expected = parser.parseObjectsFromFile<std::vector>("session.csv");
+
+    // Row budgets: exactly 'rows' objects per step, progress growing to 1.
+    {
+        auto session = parser.openSession<std::vector>("session.csv");
+        double progress = session.progress();
+        CHECK(progress == 0);
+        std::size_t steps = 0;
+        bool exact = true, growing = true;
+        while (!session.step(CSVBudget::forRows(7000))) {
+            ++steps;
+            exact = exact && session.rows() == steps * 7000;
+            growing = growing && session.progress() > progress;
+            progress = session.progress();
+        }
+        CHECK(exact && growing);
+        CHECK(steps == expected.size() / 7000);
+        CHECK(session.done() && session.progress() == 1.0);
+        CHECK(session.step(CSVBudget::forRows(1)));
+        CHECK(session.take() == expected);
+    }
+
+    // Time budgets: a 1 ms step cannot parse the whole file, and the steps together give every object.
+    {
+        auto session = parser.openSession<std::unordered_map, int>("session.csv");
+        std::size_t steps = 1;
+        while (!session.step(CSVBudget::forTime(std::chrono::milliseconds(1)))) {
+            ++steps;
+        }
+        CHECK(steps > 1);
+        CHECK(session.rows() == expected.size() && session.result().size() == expected.size());
+        CHECK(session.result().at(299999) == expected.back());
+    }
+
+    // Two sessions interleaved on one parser; blank lines are skipped and do not count against the budget.
+    {
+        writeFile("session_blank.csv", "id,text,value\n1,a,1.5\n\n\n2,b,2.5\n\n3,c,3.5\n");
+        auto first = parser.openSession<std::vector>("session_blank.csv");
+        auto second = parser.openSession<std::vector>("session.csv");
+        CHECK(!first.step(CSVBudget::forRows(2)));
+        CHECK(!second.step(CSVBudget::forRows(5)));
+        CHECK(first.rows() == 2 && first.result().back().text == "b");
+        CHECK(first.step(CSVBudget::forRows(2)));
+        CHECK(first.rows() == 3 && second.rows() == 5);
+        CHECK(second.result().back() == expected[4]);
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <sstream>
+
+// A dataset published to a file attaches and reads back; truncated or corrupt copies are rejected on attach instead
+// of being read out of bounds.
+struct Person {
+    int id = 0;
+    std::string name;
+    double score = 0;
+
+    Person() = default;
+    Person(const int id_, std::string name_, const double score_) : id(id_), name(std::move(name_)), score(score_) {
+    }
+};
+
+#ifdef CSV_PARSER_POSIX
+
+using Dataset = CSVSharedDataset<int, std::string, double>;
+
+std::string readFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+template<typename T>
+void store(std::string &bytes, const std::size_t offset, const T value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+
+template<typename T>
+T load(const std::string &bytes, const std::size_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+bool rejected(const std::string &path) {
+    try {
+        Dataset::attach(path);
+        return false;
+    } catch (const CSVException &) {
+        return true;
+    }
+}
+
+int main() {
+    std::string content = "id,name,score\n";
+    for (int row = 0; row < 100; ++row) {
+        content += std::format("{},name {},{}.5\n", row, row, row);
+    }
+    const std::string csv = writeFile("shared_dataset.csv", content);
+
+    CSVParser<Person, int, std::string, double> parser;
+    parser.setVerbose(false);
+    parser.publishDataset(csv, "shared_dataset.bin");
+    {
+        const Dataset dataset = Dataset::attach("shared_dataset.bin");
+        CHECK(dataset.rows() == 100);
+        CHECK(dataset.get<0>(42) == 42);
+        CHECK(dataset.get<1>(42) == "name 42");
+        CHECK(dataset.column<2>()[99] == 99.5);
+        CHECK(dataset.object<Person>(7).name == "name 7");
+    }
+
+    // Header: magic, version, columns, rows (offset 16), signature, size (offset 32), then one offset per column.
+    const std::string valid = readFile("shared_dataset.bin");
+    const std::size_t column_offsets = 40;
+    const auto text_column = load<std::uint64_t>(valid, column_offsets + sizeof(std::uint64_t));
+
+    CHECK(!rejected(writeFile("shared_dataset_copy.bin", valid)));
+    CHECK(rejected(writeFile("shared_dataset_truncated.bin", valid.substr(0, valid.size() / 2))));
+
+    std::string corrupt = valid;
+    store<std::uint64_t>(corrupt, 16, 1'000'000);
+    CHECK(rejected(writeFile("shared_dataset_rows.bin", corrupt)));
+
+    corrupt = valid;
+    store<std::uint64_t>(corrupt, column_offsets + 2 * sizeof(std::uint64_t), valid.size() - 8);
+    CHECK(rejected(writeFile("shared_dataset_column.bin", corrupt)));
+
+    corrupt = valid;
+    store<std::uint64_t>(corrupt, text_column + 50 * sizeof(std::uint64_t), 0);
+    CHECK(rejected(writeFile("shared_dataset_decreasing.bin", corrupt)));
+
+    corrupt = valid;
+    store<std::uint64_t>(corrupt, text_column + 100 * sizeof(std::uint64_t), valid.size());
+    CHECK(rejected(writeFile("shared_dataset_text.bin", corrupt)));
+
+    CHECK(Dataset::remove("shared_dataset.bin"));
+    return check_failures ? 1 : 0;
+}
+
+#else
+
+int main() {
+    return 0;
+}
+
+#endif
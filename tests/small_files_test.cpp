@@ -0,0 +1,110 @@
+#include <CSVParser.h>
+#include "check.h"
+
+#include <unordered_map>
+
+// Batch parsing of many small files: each result equals a one-file parse, in input order, and a file that cannot be
+// read or parsed only fails itself, with its error message.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    [[nodiscard]] int getId() const {
+        return id;
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+using Parser = CSVParser<Record, int, std::string, double>;
+
+// File 'number' has 'number % 7' rows, quoted fields, blank lines and CRLF line endings on some of them.
+std::string smallFile(const int number, const char delimiter) {
+    const std::string line_ending = number % 3 ? "\n" : "\r\n";
+    const std::string separator(1, delimiter);
+    std::string content = "id" + separator + "text" + separator + "value" + line_ending;
+    for (int row = 0; row < number % 7; ++row) {
+        const std::string id = std::to_string(number * 100 + row);
+        content += row % 2 ? id + separator + "plain " + id + separator + std::to_string(row) + ".5" + line_ending
+                           : id + separator + "\"quoted" + separator + " " + id + "\"" + separator + std::to_string(row) + line_ending;
+        if (row == 2) {
+            content += line_ending;
+        }
+    }
+    return content;
+}
+
+int main() {
+    std::vector<std::string> files = {"small_files_missing.csv"};
+    for (int number = 0; number < 150; ++number) {
+        files.push_back(writeFile(std::format("small_files_{}.csv", number), smallFile(number, ',')));
+    }
+    files.push_back(writeFile("small_files_bad_row.csv", "id,text,value\n1,a,1.5\n2,\xFF,2.5\n"));
+    files.push_back(writeFile("small_files_bad_header.csv", "id,text\n1,a\n"));
+    files.push_back(writeFile("small_files_empty.csv", ""));
+
+    Parser sequential;
+    sequential.setVerbose(false);
+    std::vector<std::vector<Record>> expected;
+    std::size_t expected_rows = 0;
+    // Header-only files cannot be sniffed on their own: the one-file parse reports them and returns no objects.
+    std::clog.setstate(std::ios::failbit);
+    for (int number = 0; number < 150; ++number) {
+        expected.push_back(sequential.parseObjectsFromFile<std::vector>(std::format("small_files_{}.csv", number)));
+        expected_rows += expected.back().size();
+    }
+    std::clog.clear();
+
+    {
+        Parser parser;
+        parser.setThreads(4);
+        parser.setValidateUTF8(true);
+        const auto batch = parser.parseSmallFiles<std::vector>(files);
+        CHECK(batch.results.size() == files.size() && batch.errors.size() == files.size());
+        CHECK(batch.failed == 4);
+        CHECK(batch.errors.front().find("small_files_missing.csv") != std::string::npos);
+        bool equal = true;
+        for (std::size_t number = 0; number < expected.size(); ++number) {
+            equal = equal && batch.errors[number + 1].empty() && batch.results[number + 1] == expected[number];
+        }
+        CHECK(equal);
+        CHECK(batch.errors.end()[-3].find("UTF-8") != std::string::npos && batch.errors.end()[-3].find("[3]") != std::string::npos);
+        CHECK(!batch.errors.end()[-2].empty() && batch.results.end()[-2].empty());
+        CHECK(!batch.errors.back().empty() && batch.results.back().empty());
+        // The rows of a file failing midway are counted up to the failure.
+        CHECK(parser.getStats().rows == expected_rows + 1);
+        CHECK(parser.getStats().chunks == files.size());
+    }
+
+    // Keyed containers, and a dialect set beforehand instead of detected on the first file.
+    {
+        std::vector<std::string> semicolon;
+        for (int number = 0; number < 40; ++number) {
+            semicolon.push_back(writeFile(std::format("small_files_semicolon_{}.csv", number), smallFile(number, ';')));
+        }
+        Parser parser;
+        parser.setDelimiter(';');
+        parser.setThreads(3);
+        const auto batch = parser.parseSmallFiles<std::unordered_map, int>(semicolon);
+        CHECK(batch.failed == 0);
+        bool equal = batch.results.size() == semicolon.size();
+        for (std::size_t number = 0; equal && number < semicolon.size(); ++number) {
+            equal = batch.results[number].size() == expected[number].size();
+            for (const Record &record: expected[number]) {
+                const auto found = batch.results[number].find(record.id);
+                std::string text = record.text;
+                std::ranges::replace(text, ',', ';');
+                equal = equal && found != batch.results[number].end() && found->second.value == record.value &&
+                        found->second.text == text;
+            }
+        }
+        CHECK(equal);
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <map>
+#include <regex>
+#include <set>
+
+// Timeline traces: a parallel parse records its phases on every thread, the export is well-formed Chrome trace JSON,
+// and traces only record while set, into the right trace, until cleared.
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+struct Span {
+    std::string name;
+    unsigned tid = 0;
+    double begin = 0, duration = 0;
+    std::uint64_t rows = 0;
+};
+
+// Complete events of a trace, in export order.
+std::vector<Span> spans(const std::string &json) {
+    static const std::regex event(R"re(\{"name":"([^"]+)","cat":"csv","ph":"X","pid":1,"tid":(\d+),"ts":([0-9.]+),"dur":([0-9.]+)(,"args":\{"(\w+)":(\d+)\})?\})re");
+    std::vector<Span> result;
+    for (auto match = std::sregex_iterator(json.begin(), json.end(), event); match != std::sregex_iterator(); ++match) {
+        const auto &groups = *match;
+        result.push_back({groups[1], static_cast<unsigned>(std::stoul(groups[2])), std::stod(groups[3]), std::stod(groups[4]),
+                          groups[6] == "rows" ? std::stoull(groups[7]) : 0});
+    }
+    return result;
+}
+
+// Brackets and braces balance outside of strings, and strings end.
+bool balanced(const std::string &json) {
+    std::string open;
+    bool in_string = false;
+    for (std::size_t index = 0; index < json.size(); ++index) {
+        const char symbol = json[index];
+        if (in_string) {
+            index += symbol == '\\';
+            in_string = symbol != '"';
+        } else if (symbol == '"') {
+            in_string = true;
+        } else if (symbol == '{' || symbol == '[') {
+            open.push_back(symbol == '{' ? '}' : ']');
+        } else if (symbol == '}' || symbol == ']') {
+            if (open.empty() || open.back() != symbol) {
+                return false;
+            }
+            open.pop_back();
+        }
+    }
+    return open.empty() && !in_string;
+}
+
+int main() {
+    corpus::typicalRows("trace.csv", 300000);
+    CSVTrace trace;
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    parser.setThreads(4);
+    parser.setTrace(&trace);
+    const auto records = parser.parseObjectsFromFile<std::vector>("trace.csv");
+    CHECK(records.size() == 300000);
+
+    const std::string json = trace.toJSON();
+    CHECK(balanced(json) && json.starts_with("{\"traceEvents\":["));
+    const std::vector<Span> events = spans(json);
+    CHECK(events.size() == trace.spanCount());
+
+    std::map<std::string, std::size_t> counts;
+    std::set<unsigned> chunk_threads;
+    std::uint64_t chunk_rows = 0;
+    bool timed = true;
+    for (const Span &span: events) {
+        ++counts[span.name];
+        timed = timed && span.begin >= 0 && span.duration >= 0;
+        if (span.name == "parse chunk") {
+            chunk_threads.insert(span.tid);
+            chunk_rows += span.rows;
+        }
+    }
+    CHECK(timed);
+    for (const char *phase: {"sniff header", "plan chunks", "read block", "parse chunk", "insert"}) {
+        CHECK(counts[phase] > 0);
+    }
+    CHECK(counts["parse chunk"] == parser.getStats().chunks && chunk_rows == records.size());
+    std::cout << std::format("{} spans, {} chunks parsed on {} threads", events.size(), counts["parse chunk"], chunk_threads.size()) << std::endl;
+    CHECK(chunk_threads.size() > 1);
+    CHECK(json.find(R"("ph":"M")") != std::string::npos && json.find("\"worker 1\"") != std::string::npos);
+
+    // The trace is written as exported.
+    CHECK(trace.write("trace.json"));
+    std::ifstream file("trace.json", std::ios::binary);
+    CHECK(std::string(std::istreambuf_iterator<char>(file), {}) == json);
+
+    // Thread names are escaped; a second trace on the same thread gets its own spans.
+    trace.clear();
+    CHECK(trace.spanCount() == 0);
+    CSVTrace other;
+    trace.nameThread("main \"loop\"\n");
+    trace.record("first", std::chrono::steady_clock::now(), std::chrono::steady_clock::now());
+    other.record("second", std::chrono::steady_clock::now(), std::chrono::steady_clock::now());
+    trace.record("third", std::chrono::steady_clock::now(), std::chrono::steady_clock::now());
+    CHECK(trace.spanCount() == 2 && other.spanCount() == 1);
+    CHECK(balanced(trace.toJSON()) && trace.toJSON().find(R"("main \"loop\" ")") != std::string::npos);
+    CHECK(other.toJSON().find("\"second\"") != std::string::npos && trace.toJSON().find("\"second\"") == std::string::npos);
+
+    // Unset, nothing more is recorded.
+    parser.setTrace(nullptr);
+    parser.setThreads(1);
+    CHECK(parser.parseObjectsFromFile<std::vector>("trace.csv").size() == 300000);
+    CHECK(trace.spanCount() == 2);
+
+    return check_failures ? 1 : 0;
+}
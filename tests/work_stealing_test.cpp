@@ -0,0 +1,123 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+#include <sys/resource.h>
+
+// The work-stealing pool: nested tasks, reuse across runs, a failing task, and idle workers that sleep instead of
+// spinning. Batch parsing on it isolates failures per file.
+struct Value {
+    int id = 0;
+
+    Value() = default;
+    explicit Value(const int id_) : id(id_) {
+        if (id == 777) {
+            throw std::runtime_error("bad row");
+        }
+    }
+
+    bool operator==(const Value &) const = default;
+};
+
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+
+    bool operator==(const Record &) const = default;
+};
+
+double cpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+           static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+int main() {
+    {
+        CSVWorkStealingPool pool(8);
+
+        // One long task: the 7 other workers wait on the condition variable and use almost no CPU.
+        pool.push([] { std::this_thread::sleep_for(std::chrono::milliseconds(300)); });
+        const double before = cpuSeconds();
+        pool.run();
+        const double idle = cpuSeconds() - before;
+        std::cout << std::format("CPU time while 7 workers were idle for 300 ms: {:.3f} s", idle) << std::endl;
+        CHECK(idle < 0.15);
+
+        // Tasks pushing tasks, over many runs of the same workers.
+        std::atomic<int> executed{0};
+        for (int round = 0; round < 50; ++round) {
+            for (int task = 0; task < 20; ++task) {
+                pool.push([&] {
+                    for (int nested = 0; nested < 5; ++nested) {
+                        pool.push([&] { ++executed; });
+                    }
+                    ++executed;
+                });
+            }
+            pool.run();
+        }
+        CHECK(executed == 50 * 20 * 6);
+
+        // A throwing task is rethrown by run(); the pool stays usable.
+        pool.push([] { throw std::runtime_error("task failed"); });
+        CHECK(throws<std::runtime_error>([&] { pool.run(); }));
+        pool.push([&] { ++executed; });
+        pool.run();
+        CHECK(executed == 50 * 20 * 6 + 1);
+    }
+
+    // A constructor throwing in one file fails that file only; a missing file is reported and skipped.
+    {
+        std::string first = "id\n", second = "id\n";
+        for (int row = 0; row < 1000; ++row) {
+            first += std::to_string(row) + "\n";
+            second += std::to_string(row + 1000) + "\n";
+        }
+        writeFile("work_stealing_a.csv", first);
+        writeFile("work_stealing_b.csv", second);
+
+        CSVParser<Value, int> parser;
+        parser.setVerbose(false);
+        parser.setThreads(4);
+        std::clog.setstate(std::ios::failbit);
+        const auto results = parser.parseObjectsFromFiles<std::vector>({"work_stealing_a.csv", "work_stealing_missing.csv", "work_stealing_b.csv"});
+        std::clog.clear();
+        CHECK(results.size() == 3);
+        if (results.size() == 3) {
+            CHECK(results[0].empty());
+            CHECK(results[1].empty());
+            CHECK(results[2].size() == 1000 && results[2].front().id == 1000 && results[2].back().id == 1999);
+        }
+    }
+
+    // Large files are split into chunks that idle workers steal; each result matches a sequential parse.
+    {
+        corpus::typicalRows("work_stealing_large_a.csv", 250000);
+        corpus::typicalRows("work_stealing_large_b.csv", 180000);
+        corpus::typicalRows("work_stealing_small.csv", 100);
+
+        CSVParser<Record, int, std::string, double> sequential;
+        sequential.setVerbose(false);
+        const std::vector<std::string> files = {"work_stealing_large_a.csv", "work_stealing_small.csv", "work_stealing_large_b.csv"};
+
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        parser.setThreads(4);
+        const auto results = parser.parseObjectsFromFiles<std::vector>(files);
+        CHECK(results.size() == files.size());
+        for (std::size_t file = 0; file < std::min(results.size(), files.size()); ++file) {
+            CHECK(results[file] == sequential.parseObjectsFromFile<std::vector>(files[file]));
+        }
+        CHECK(parser.getStats().rows == 250000 + 100 + 180000);
+        CHECK(parser.getStats().chunks > files.size());
+    }
+
+    return check_failures ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+#include <CSVParser.h>
+#include "check.h"
+#include "corpus.h"
+
+// Parse time must grow linearly with the size of adversarial inputs: each input is parsed at a small and an 8 times
+// larger size, and the time ratio must stay below 3 x 8 (a quadratic path gives about 64). The margin covers the
+// small input fitting in the cache and the large one not (a linear parse then measures up to about 2 x 8).
+struct Record {
+    int id = 0;
+    std::string text;
+    double value = 0;
+
+    Record() = default;
+    Record(const int id_, std::string text_, const double value_) : id(id_), text(std::move(text_)), value(value_) {
+    }
+};
+
+constexpr std::size_t growth = 8;
+constexpr double max_ratio = 3.0 * growth;
+
+template<typename Generate, typename Parse>
+void checkLinear(const char *name, Generate &&generate, Parse &&parse, const std::size_t small) {
+    const std::string path = std::string("worst_case_") + name + ".csv";
+    const std::size_t small_bytes = generate(path, small);
+    const double small_seconds = corpus::bestSeconds(3, [&] { parse(path); });
+    const std::size_t large_bytes = generate(path, small * growth);
+    const double large_seconds = corpus::bestSeconds(3, [&] { parse(path); });
+
+    const double ratio = large_seconds / std::max(small_seconds, 1e-6);
+    std::cout << std::format("{}: {} -> {} bytes, {:.4f} -> {:.4f} s (x{:.1f}), {:.1f} MB/s", name, small_bytes, large_bytes,
+                             small_seconds, large_seconds, ratio, static_cast<double>(large_bytes) / large_seconds / 1e6) << std::endl;
+    CHECK(ratio < max_ratio);
+}
+
+int main() {
+    const auto parseRecords = [](const std::string &path) {
+        CSVParser<Record, int, std::string, double> parser;
+        parser.setVerbose(false);
+        const auto records = parser.parseObjectsFromFile<std::vector>(path);
+        CHECK(!records.empty());
+    };
+
+    // Rows longer than the reader's block: the line search must resume, not restart, after each refill. Small blocks
+    // make a restarting search obvious (hundreds of refills per row).
+    checkLinear("block_reader_long_row", corpus::longQuotedRow, [](const std::string &path) {
+        CSVBlockReader reader(1 << 10);
+        reader.open(path);
+        char *line_begin, *line_end;
+        std::size_t lines = 0;
+        while (reader.nextLine(line_begin, line_end)) {
+            ++lines;
+        }
+        CHECK(lines == 2);
+    }, 1 << 20);
+    checkLinear("long_quoted_row", corpus::longQuotedRow, parseRecords, 4 << 20);
+    checkLinear("blank_run", corpus::blankRun, parseRecords, 1 << 20);
+    checkLinear("invalid_numbers", corpus::invalidNumbers, parseRecords, 50000);
+
+    checkLinear("wide_rows", [](const std::string &path, const std::size_t columns) {
+        return corpus::wideRows(path, columns, 4);
+    }, [](const std::string &path) {
+        CSVParser<std::vector<std::string>, std::string> parser;
+        parser.setVerbose(false);
+        const auto rows = parser.parseObjectsFromFile<std::vector>(path);
+        CHECK(rows.size() == 4);
+    }, 20000);
+
+    // The long quoted field comes back unescaped and whole.
+    corpus::longQuotedRow("worst_case_content.csv", 1000);
+    CSVParser<Record, int, std::string, double> parser;
+    parser.setVerbose(false);
+    const auto records = parser.parseObjectsFromFile<std::vector>("worst_case_content.csv");
+    CHECK(records.size() == 1);
+    if (!records.empty()) {
+        CHECK(records[0].text.starts_with("lorem,\"ipsum\" dolor,lorem,"));
+        CHECK(records[0].value == 2.5);
+    }
+
+    return check_failures ? 1 : 0;
+}